@@ -13,6 +13,8 @@
 #include "TickTwo.h"
 #include "AiEsp32RotaryEncoder.h"
 #include "time.h"
+#include <DayriseProtocol.h> // lib/DayriseProtocol of this repository, install it as a library
+#include <DayriseLog.h> // lib/DayriseLog of this repository, install it as a library
 
 
 
@@ -76,6 +78,8 @@
 
 #define MAX_PARTS 10
 
+#define TELEMETRY_INTERVAL_S 60 // the display reports its health every minute
+
 
 // global variables -----------------------------------
 int event;
@@ -94,6 +98,13 @@ int minute;
 bool connectOnce;
 int alarmHour;
 int alarmMin;
+// display link: telemetry coming back from the display, alarm frame waiting to be sent
+PROTOCOL_PARSER displayParser;
+unsigned long lastTelemetry;
+unsigned long displayFrameMs; // time the display needs for one frame, alarm frames are not sent faster
+PROTOCOL_ALARM pendingAlarm;
+bool alarmPending;
+unsigned long lastAlarmSent;
 uint8_t receiverAddress[] = {0xCC, 0xDB, 0xA7, 0x56, 0x2E, 0xD8};
 
 // global objects -------------------------------------
@@ -227,8 +238,7 @@ void checkForEvents(){
     case WAKEUP_DEACTIVATED_STATE:
       break;
     case PLAY_ALARM_STATE:
-   
-    Serial.println("Alarm_State");
+      LOG_INFO("Alarm_State");
       playAlarmSound();
       break;       
   }
@@ -272,7 +282,9 @@ void IRAM_ATTR readEncoderISR()
 void setup() {
   // serial port with baud rate
   Serial.begin(115200);
+  Log_Start(); // the hot paths log through the ring buffer, the log task writes it to Serial
   SerialPort.begin(115200, SERIAL_8N1, 16, 17);
+  Protocol_Init(&displayParser);
 
   // Set microSD Card CS as OUTPUT and set HIGH
   pinMode(SD_CS, OUTPUT);      
@@ -318,6 +330,7 @@ void setup() {
   rotaryInputTicker.start();
   // Serial.println("Setup complete");
   printDateTime();
+  requestTelemetry();
   
 }
 
@@ -328,6 +341,10 @@ void loop() {
   stateMachineTicker.update();
   rotaryInputTicker.update();
   maintainTimeTicker.update();
+
+  // display link
+  receiveTelemetry();
+  sendPendingAlarm();
   
   if(state == PLAY_ALARM_STATE){
     audio.loop();
@@ -499,30 +516,115 @@ void setAlarmTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8
   alarmTime = RtcDateTime(year, month, day, hour, minute, second);
 }
 
+/*
+ * Send a frame to the display. The display sleeps between updates and is woken up by the
+ * first falling edge on its RX line, which costs it that byte. So a wake byte goes first
+ * and the frame follows once the display is awake.
+ */
+void sendFrame(const uint8_t *frame, size_t len){
+  SerialPort.write(PROTOCOL_WAKE);
+  SerialPort.flush();
+  delay(PROTOCOL_WAKE_MS);
+  SerialPort.write(frame, len);
+}
+
+/*
+ * Ask the display to report its health now and every TELEMETRY_INTERVAL_S seconds.
+ */
+void requestTelemetry(){
+  PROTOCOL_TELEMETRY_REQUEST request;
+  request.Interval = TELEMETRY_INTERVAL_S;
+  uint8_t frame[PROTOCOL_FRAME_SIZE(PROTOCOL_TELEMETRY_REQUEST_SIZE)];
+  sendFrame(frame, Protocol_EncodeTelemetryRequest(frame, sizeof(frame), &request));
+  lastTelemetry = millis();
+}
+
+/*
+ * Called by the parser for every frame from the display.
+ * Log the telemetry and adapt the alarm frame rate to the time the display needs per frame.
+ */
+void onDisplayFrame(void *arg, const PROTOCOL_FRAME *frame){
+  PROTOCOL_TELEMETRY telemetry;
+  if(!Protocol_DecodeTelemetry(frame, &telemetry)){
+    return;
+  }
+  lastTelemetry = millis();
+  displayFrameMs = (telemetry.RenderUs + telemetry.TransferUs + telemetry.RefreshUs) / 1000;
+
+  LOG_INFO("Display: %lu frames, render %lu us, transfer %lu us (%lu bytes), refresh %lu us, skipped %lu, coalesced %lu",
+           (unsigned long)telemetry.Frames, (unsigned long)telemetry.RenderUs, (unsigned long)telemetry.TransferUs,
+           (unsigned long)telemetry.TransferBytes, (unsigned long)telemetry.RefreshUs,
+           (unsigned long)telemetry.Skipped, (unsigned long)telemetry.Coalesced);
+  LOG_INFO("Display: %lu dropped, %lu rx overflows, %lu rx errors, heap %lu free, %lu min",
+           (unsigned long)telemetry.QueueDrops, (unsigned long)telemetry.RxOverflows, (unsigned long)telemetry.RxErrors,
+           (unsigned long)telemetry.FreeHeap, (unsigned long)telemetry.MinFreeHeap);
+}
+
+/*
+ * Feed the bytes sent by the display to the parser.
+ * If the display stays silent (e.g. after a reset it forgot the request), ask again.
+ */
+void receiveTelemetry(){
+  uint8_t buffer[64];
+  int len;
+  while((len = SerialPort.available()) > 0){
+    len = SerialPort.read(buffer, len < (int)sizeof(buffer) ? len : sizeof(buffer));
+    Protocol_Feed(&displayParser, buffer, len, onDisplayFrame, NULL);
+  }
+  if(millis() - lastTelemetry > 3000UL * TELEMETRY_INTERVAL_S){
+    LOG_INFO("No telemetry from the display, asking again");
+    requestTelemetry();
+  }
+}
+
+/*
+ * Send the newest alarm frame, but not faster than the display can show frames.
+ * Detents in between are dropped, the display would only skip them anyway.
+ */
+void sendPendingAlarm(){
+  if(!alarmPending || millis() - lastAlarmSent < displayFrameMs){
+    return;
+  }
+  uint8_t frame[PROTOCOL_FRAME_SIZE(PROTOCOL_ALARM_SIZE)];
+  sendFrame(frame, Protocol_EncodeAlarm(frame, sizeof(frame), &pendingAlarm));
+  lastAlarmSent = millis();
+  alarmPending = false;
+}
+
 /*
  * Format Time and Date and print it to the Serial Monitor.
  */
 void printDateTime(){
 
   // date
-  Serial.print("Aktuelles Datum: ");
-  char dateString[11];
-  snprintf_P(dateString, sizeof(dateString), PSTR("%02u.%02u.%04u"), currentTime.Day(), currentTime.Month(), currentTime.Year());  // snprintf_P => format String 
-  Serial.println(dateString);
+  LOG_INFO("Aktuelles Datum: %02u.%02u.%04u", currentTime.Day(), currentTime.Month(), currentTime.Year());
 
   // time
-  Serial.print("Aktuelle Uhrzeit: ");
   char timeString[6];
   snprintf_P(timeString, sizeof(timeString), PSTR("%02u:%02u"), currentTime.Hour(), currentTime.Minute());  // snprintf_P => format String 
-  Serial.println(timeString);
-  String remainingTimeString = " ";
-  if(alarmActive){
-    remainingTimeString = calculateRemainingTime();
+  LOG_INFO("Aktuelle Uhrzeit: %s", timeString);
+
+  // send the time to the display
+  PROTOCOL_TIME frameTime;
+  frameTime.Hour = currentTime.Hour();
+  frameTime.Min = currentTime.Minute();
+  frameTime.HasRemaining = alarmActive && calculateRemainingTime(&frameTime.RemainingHour, &frameTime.RemainingMin);
+  if(!frameTime.HasRemaining){
+    frameTime.RemainingHour = 0;
+    frameTime.RemainingMin = 0;
+  }
+
+  // same text as the old "0|hh:mm|hh:mm" line, formatted without heap allocations
+  if(frameTime.HasRemaining){
+    LOG_INFO("0|%s|%02u:%02u", timeString, frameTime.RemainingHour, frameTime.RemainingMin);
   }else{
-    remainingTimeString = "-";
+    LOG_INFO("0|%s|-", timeString);
   }
-  Serial.println("0|" + String(timeString) + "|" + remainingTimeString);
-  SerialPort.println("0|" + String(timeString) + "|" + remainingTimeString + "");
+
+  // the time screen replaces the alarm screen, an alarm frame still waiting would bring it back
+  alarmPending = false;
+  uint8_t frame[PROTOCOL_FRAME_SIZE(PROTOCOL_TIME_SIZE)];
+  sendFrame(frame, Protocol_EncodeTime(frame, sizeof(frame), &frameTime));
 
 }
 
@@ -534,7 +636,6 @@ void printDateTime(){
 void maintainTime(){
   if(currentTime.Minute() != rtc.GetDateTime().Minute() && state != ENTER_WAKEUP_TIME_STATE) {
     currentTime =  rtc.GetDateTime(); 
-    Serial.println(" ");
     
     printDateTime();
 
@@ -549,60 +650,19 @@ void maintainTime(){
 
 
  /*
- * Calculate the remaining time between the current time (currentTime) and the alarm time (alarmTime).
- * The resulting remaining time is returned as a string in the format "HH:MM" using the createRemainingTimeString() function.
- * If the current time is later than or equal to the alarm time, return a dash ("-") to indicate no remaining time.
+ * Calculate the remaining time between the current time (currentTime) and the alarm time (alarmTime) in hours and minutes.
+ * If the current time is later than the alarm time, return false to indicate no remaining time (the display shows "-").
  */
-String calculateRemainingTime(){
-  Serial.print("remaining time: ");
+bool calculateRemainingTime(uint8_t *remainingHour, uint8_t *remainingMin){
+  if(currentTime > alarmTime){
+    return false;
+  }
   // Calculate time difference from seconds since 1/1/2000 and convert back to minutes.
   remainingTime = (alarmTime.TotalSeconds()-currentTime.TotalSeconds())/60; 
-  // convert remaining time to format: hh:mm
-  double remainingHour = remainingTime/60;
-  int remainingHourInt = (int)remainingHour;
-  double remainingDecimalMin = remainingHour - remainingHourInt;
-  double remainingFormattedMin = remainingDecimalMin * 60;
-  int remainingFormattedMinInt = (int)remainingFormattedMin;
-  if(currentTime <= alarmTime){
-    return createRemainingTimeString(remainingHourInt, remainingFormattedMinInt );
-  }else{
-    Serial.println("-");
-    String noRemainingTime = "-";
-    return noRemainingTime;
-  }
-
-  return "-";
-}
-
-/*
- * Create a string representation of the remaining time in the format "HH:MM" based on the provided 'remainingHour' and 'remainingMin'.
- * The resulting string is stored in the variable 'remainingTimeString' and returned.
- */
-String createRemainingTimeString( int remainingHour, int remainingMin){
-  String remainingHourString = String(remainingHour);
-  String remainingMinString = String(remainingMin);
-  String remainingTimeString = " ";
-  if(remainingHour < 10 && remainingMin >= 10){
-    Serial.println("0" + remainingHourString + ":" + remainingMinString);
-    remainingTimeString = "0" + remainingHourString + ":" + remainingMinString;
-    return remainingTimeString;
-  }
-  if(remainingHour < 10 && remainingMin < 10){
-    Serial.println("0" + remainingHourString + ":0" + remainingMinString);
-    remainingTimeString = "0" + remainingHourString + ":0" + remainingMinString;
-    return remainingTimeString;
-  }
-  if(remainingHour >= 10 && remainingMin < 10){
-    Serial.println(remainingHourString + ":0" + remainingMinString);
-    remainingTimeString = remainingHourString + ":0" + remainingMinString;
-    return remainingTimeString;
-  }
-  if(remainingHour >= 10 && remainingMin >= 10){
-    Serial.println(remainingHourString + ":" + remainingMinString);
-    remainingTimeString = remainingHourString + ":" + remainingMinString;
-    return remainingTimeString;
-  }
-  return " ";
+  uint32_t remainingMinutes = (uint32_t)remainingTime;
+  *remainingHour = remainingMinutes / 60;
+  *remainingMin = remainingMinutes % 60;
+  return true;
 }
 
 
@@ -630,9 +690,9 @@ void rotaryInput(){
   // choose between offline and online mode
   if(state == SELECT_OFFLINE_ONLINE_STATE){
     if(!didOnce){
-      Serial.println("Please choose Offline or Online Mode by rotating the selection wheel.");
-      Serial.println("Confirm the correct mode by pressing the selection wheel.");
-      Serial.println("Mode: Online");
+      LOG_INFO("Please choose Offline or Online Mode by rotating the selection wheel.");
+      LOG_INFO("Confirm the correct mode by pressing the selection wheel.");
+      LOG_INFO("Mode: Online");
       rotaryEncoder.setBoundaries(0, 1, true); //minValue, maxValue, circleValues true|false
       rotaryEncoder.setEncoderValue(0);
       rotaryEncoder.disableAcceleration();
@@ -641,18 +701,18 @@ void rotaryInput(){
 
     if(rotaryEncoder.encoderChanged()){
       if(rotaryEncoder.readEncoder() == 0){
-        Serial.println("Mode: Online");
+        LOG_INFO("Mode: Online");
       }else{
-        Serial.println("Mode: Offline");
+        LOG_INFO("Mode: Offline");
       }
     }
     if(rotaryEncoder.isEncoderButtonClicked()){
       if(rotaryEncoder.readEncoder() == 0){
         event = ONLINE_SELECTED_EVENT;
-        Serial.println("Selected Mode: Online !");
+        LOG_INFO("Selected Mode: Online !");
       }else{
         event = OFFLINE_SELECTED_EVENT;
-        Serial.println("Selected Mode: Offline !");
+        LOG_INFO("Selected Mode: Offline !");
       }
       didOnce = false;
     }
@@ -672,21 +732,19 @@ void rotaryInput(){
         if(state == ENTER_OFFLINE_TIME_STATE){
           // Allows one time output to the console, inside a continuously called Ticker / Thread. (Variable didOnce need to be set to false after calling the function to get expected behavior)
           if(!didOnce){
-            Serial.println("Please select the current year, month, day, hour and minute by rotating the selection wheel.");
-            Serial.println("Confirm the correct time/date information by pressing the selection wheel.");
+            LOG_INFO("Please select the current year, month, day, hour and minute by rotating the selection wheel.");
+            LOG_INFO("Confirm the correct time/date information by pressing the selection wheel.");
             rotaryEncoder.setBoundaries(0, 9999, true);
             rotaryEncoder.setEncoderValue(2023);
           }
           didOnce = true;
         }
         if(rotaryEncoder.encoderChanged()){
-           Serial.print("Year: ");
-           Serial.println(rotaryEncoder.readEncoder());
+           LOG_INFO("Year: %ld", (long)rotaryEncoder.readEncoder());
         }
         if(rotaryEncoder.isEncoderButtonClicked()){
           year = rotaryEncoder.readEncoder();
-          Serial.print("Selected Year: ");
-          Serial.println(year);
+          LOG_INFO("Selected Year: %ld", (long)year);
           clickNumber = clickNumber + 1;
           didOnce = false;
         }
@@ -699,13 +757,11 @@ void rotaryInput(){
         }
         didOnce = true;
         if(rotaryEncoder.encoderChanged()){
-           Serial.print("Month: ");
-           Serial.println(rotaryEncoder.readEncoder());
+           LOG_INFO("Month: %ld", (long)rotaryEncoder.readEncoder());
         }
         if(rotaryEncoder.isEncoderButtonClicked()){
           month = rotaryEncoder.readEncoder();
-          Serial.print("Selected Month: ");
-          Serial.println(month);
+          LOG_INFO("Selected Month: %ld", (long)month);
           clickNumber = clickNumber + 1;
           didOnce = false;
         }
@@ -718,13 +774,11 @@ void rotaryInput(){
         }
         didOnce = true;
         if(rotaryEncoder.encoderChanged()){
-            Serial.print("Day: ");
-            Serial.println(rotaryEncoder.readEncoder());
+            LOG_INFO("Day: %ld", (long)rotaryEncoder.readEncoder());
         }
         if(rotaryEncoder.isEncoderButtonClicked()){
           day = rotaryEncoder.readEncoder();
-          Serial.print("Selected Day: ");
-          Serial.println(day);
+          LOG_INFO("Selected Day: %ld", (long)day);
           clickNumber = clickNumber + 1;
           didOnce = false;
         }
@@ -734,8 +788,8 @@ void rotaryInput(){
         if(state == ENTER_WAKEUP_TIME_STATE){
           // Allows one time output to the console, inside a continuously called Ticker / Thread. (Variable didOnce need to be set to false after calling the function to get expected behavior)
           if(!didOnce){
-            Serial.println("Please select the alarm time (hour and minute) by rotating the selection wheel.");
-            Serial.println("Confirm the correct time information by pressing the selection wheel.");
+            LOG_INFO("Please select the alarm time (hour and minute) by rotating the selection wheel.");
+            LOG_INFO("Confirm the correct time information by pressing the selection wheel.");
             printAlarmTime(false, alarmMin, 0);
           }
         } 
@@ -746,15 +800,13 @@ void rotaryInput(){
         }
         didOnce = true;
         if(rotaryEncoder.encoderChanged()){
-            Serial.print("Hour: ");
-            Serial.println(rotaryEncoder.readEncoder());
+            LOG_INFO("Hour: %ld", (long)rotaryEncoder.readEncoder());
             alarmHour = rotaryEncoder.readEncoder();
             printAlarmTime(true, rotaryEncoder.readEncoder(), 0);
         }
         if(rotaryEncoder.isEncoderButtonClicked()){
           hour = rotaryEncoder.readEncoder();
-          Serial.print("Selected Hour: ");
-          Serial.println(hour);
+          LOG_INFO("Selected Hour: %ld", (long)hour);
           clickNumber = clickNumber + 1;
           didOnce = false;
         }
@@ -767,15 +819,13 @@ void rotaryInput(){
         }
         didOnce = true;
         if(rotaryEncoder.encoderChanged()){
-            Serial.print("Min: ");
-            Serial.println(rotaryEncoder.readEncoder());
+            LOG_INFO("Min: %ld", (long)rotaryEncoder.readEncoder());
             alarmMin = rotaryEncoder.readEncoder();
             printAlarmTime(false, rotaryEncoder.readEncoder(), 0);
         }
         if(rotaryEncoder.isEncoderButtonClicked()){
           minute = rotaryEncoder.readEncoder();
-          Serial.print("Selected Minute: ");
-          Serial.println(minute);
+          LOG_INFO("Selected Minute: %ld", (long)minute);
           clickNumber = clickNumber + 1;
         }
         break;
@@ -788,7 +838,7 @@ void rotaryInput(){
       clickNumber = 0;
       if(state == ENTER_OFFLINE_TIME_STATE){
         setCurrentTime(year, month, day, hour, minute, 0);
-        Serial.println("Successfully set current time.");
+        LOG_INFO("Successfully set current time.");
         event = CURRENT_TIME_SELECTED_EVENT;
         currentTime =  rtc.GetDateTime(); 
         printDateTime();
@@ -803,7 +853,7 @@ void rotaryInput(){
         alarmActive = true;
         printAlarmTime(false, alarmMin, 1);
         printDateTime();
-        Serial.println("Successfully set alarm time.");
+        LOG_INFO("Successfully set alarm time.");
         event = WAKEUP_TIME_SELECTED_EVENT; 
       }
       didOnce = false;
@@ -819,25 +869,25 @@ void rotaryInput(){
     rotaryButton.update();
 
     if(rotaryButton.isDoubleClick()){
-      Serial.println("Double Click");
+      LOG_INFO("Double Click");
       event = ROTARYENCODER_DOUBLECLICK_EVENT;
       maintainTimeTicker.pause();
     }
 
     if(rotaryButton.isLongClick() && state != MAINTAIN_TIME_STATE ){
-      Serial.println("Long Click");
+      LOG_INFO("Long Click");
       alarmActive = !alarmActive;
       event = ROTARYENCODER_LONGCLICK_EVENT;
       if(alarmActive){
-          Serial.println("Alarm active");
+          LOG_INFO("Alarm active");
       }else{
-        Serial.println("Alarm inactive");
+        LOG_INFO("Alarm inactive");
       }
       printDateTime();
     }
 
     if(rotaryButton.isSingleClick()){
-      Serial.println("Single Click");
+      LOG_INFO("Single Click");
       event = ROTARYENCODER_CLICK_EVENT;
     }
 
@@ -857,49 +907,18 @@ void startMaintainTimeTicker(){
 
 /* 
  * Print the alarm time in the format "HH:MM" based on the 'hour' flag and the provided 'number' value.
- * Also, construct a string 'alarmString' in the format "1|HH:MM|status" to represent the alarm time and status.
+ * 'number' is the hour if the flag is set, the minute otherwise. The other field is taken from alarmHour/alarmMin.
+ * Also, send the alarm time and status to the display as a PROTOCOL_MSG_ALARM frame (see sendPendingAlarm()).
  */
  void printAlarmTime(bool hour, int number, int status){
-   String alarmString = "";
-      if(hour){
-        if(number < 10 && alarmMin >= 10){
-        Serial.println("0" + String(number) + ":" + String(alarmMin));
-        alarmString = "1|0" + String(number) + ":" + String(alarmMin) + "|" + status;
-        }
-        if(number < 10 && alarmMin < 10){
-          Serial.println("0" +  String(number) + ":0" + String(alarmMin));
-          alarmString = "1|0" + String(number) + ":0" + String(alarmMin) + "|" + status;
-        }
-        if(number >= 10 && alarmMin < 10){
-          Serial.println( String(number) + ":0" + String(alarmMin));
-          alarmString = "1|" + String(number) + ":0" + String(alarmMin) + "|" + status;
-        }
-        if(number >= 10 && alarmMin >= 10){
-          Serial.println( String(number) + ":" + String(alarmMin));
-          alarmString = "1|" + String(number) + ":" + String(alarmMin) + "|" + status;
-        }
-      }else{
-          if(alarmHour < 10 && number >= 10){
-          Serial.println("0" + String(alarmHour) + ":" +  String(number));
-          alarmString = "1|0" + String(alarmHour) + ":" + String(number) + "|" + status;
-        }
-        if(alarmHour < 10 && number < 10){
-          Serial.println("0" + String(alarmHour) + ":0" +  String(number));
-          alarmString = "1|0" + String(alarmHour) + ":0" + String(number) + "|" + status;
-        }
-        if(alarmHour >= 10 && number < 10){
-          Serial.println(String(alarmHour) + ":0" +  String(number));
-          alarmString = "1|" + String(alarmHour) + ":0" + String(number) + "|" + status;
-        }
-        if(alarmHour >= 10 && number >= 10){
-          Serial.println(String(alarmHour) + ":" + String(number));
-          alarmString = "1|" + String(alarmHour) + ":" + String(number) + "|" + status;
-        }
-        
-      }
-        Serial.println(alarmString);
-        SerialPort.println(alarmString + "");
-        
-        
-  }
+   PROTOCOL_ALARM frameAlarm;
+   frameAlarm.Hour = hour ? number : alarmHour;
+   frameAlarm.Min = hour ? alarmMin : number;
+   frameAlarm.State = status;
+
+   LOG_INFO("1|%02u:%02u|%d", frameAlarm.Hour, frameAlarm.Min, status);
 
+   pendingAlarm = frameAlarm;
+   alarmPending = true;
+   sendPendingAlarm();
+  }
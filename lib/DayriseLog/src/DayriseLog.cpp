@@ -0,0 +1,165 @@
+/******************************************************************************
+* | File      	:   DayriseLog.cpp
+* | Function    :   Deferred logging for the alarm clock and the display
+* | Info        :
+*   See DayriseLog.h
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-07-18
+* | Info        :
+*
+******************************************************************************/
+#include "DayriseLog.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+#if LOG_SLOTS & (LOG_SLOTS - 1)
+#error "LOG_SLOTS must be a power of two"
+#endif
+
+/**
+ * One line. Ready is set by the writer once Text is complete and cleared by
+ * the reader once it is written out.
+**/
+typedef struct {
+    uint8_t Ready;
+    uint8_t Level;
+    uint32_t Time;
+    char Text[LOG_LINE_SIZE];
+} LOG_SLOT;
+
+static LOG_SLOT Slots[LOG_SLOTS];
+static uint32_t Head;       // Next slot to claim, shared by all writers
+static uint32_t Tail;       // Next slot to write out, owned by the reader
+static uint32_t Dropped;
+static uint32_t DroppedReported;
+
+static uint32_t Log_Now(void)
+{
+#ifdef ARDUINO
+    return millis();
+#else
+    return 0;
+#endif
+}
+
+/******************************************************************************
+function: Queue a line, use the LOG_* macros instead
+parameter:
+    Level  : LOG_LEVEL_ERROR ... LOG_LEVEL_DEBUG
+    Format : printf format, a trailing line break is removed
+info:
+    Returns without waiting. If all slots are taken the line is dropped.
+******************************************************************************/
+void Log_Write(uint8_t Level, const char *Format, ...)
+{
+    uint32_t head = __atomic_load_n(&Head, __ATOMIC_RELAXED);
+    do {
+        if (head - __atomic_load_n(&Tail, __ATOMIC_ACQUIRE) >= LOG_SLOTS) {
+            __atomic_fetch_add(&Dropped, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    } while (!__atomic_compare_exchange_n(&Head, &head, head + 1, 1, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    LOG_SLOT *slot = &Slots[head & (LOG_SLOTS - 1)];
+    slot->Level = Level;
+    slot->Time = Log_Now();
+
+    va_list args;
+    va_start(args, Format);
+    int len = vsnprintf(slot->Text, sizeof(slot->Text), Format, args);
+    va_end(args);
+    if (len < 0)
+        len = 0;
+    if (len > LOG_LINE_SIZE - 1)
+        len = LOG_LINE_SIZE - 1;
+    while (len > 0 && (slot->Text[len - 1] == '\n' || slot->Text[len - 1] == '\r'))
+        slot->Text[--len] = '\0';
+
+    __atomic_store_n(&slot->Ready, 1, __ATOMIC_RELEASE);
+}
+
+/******************************************************************************
+function: Write out all finished lines in order
+parameter:
+    Writer : Receives each line with level, time stamp and line break
+return: Number of lines written
+info:
+    Only one task may flush. A line that is still being written stops the
+    flush, the lines behind it follow with the next call.
+******************************************************************************/
+uint16_t Log_Flush(LOG_WRITER Writer)
+{
+    static const char Letters[] = "-EWID";
+    char line[LOG_LINE_SIZE + 24];
+    uint16_t count = 0;
+
+    for (;;) {
+        LOG_SLOT *slot = &Slots[Tail & (LOG_SLOTS - 1)];
+        if (!__atomic_load_n(&slot->Ready, __ATOMIC_ACQUIRE))
+            break;
+        int len = snprintf(line, sizeof(line), "%c %lu.%03lu %s\r\n",
+                           Letters[slot->Level <= LOG_LEVEL_DEBUG ? slot->Level : 0],
+                           (unsigned long)(slot->Time / 1000), (unsigned long)(slot->Time % 1000), slot->Text);
+        Writer(line, len < (int)sizeof(line) ? len : sizeof(line) - 1);
+        __atomic_store_n(&slot->Ready, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&Tail, Tail + 1, __ATOMIC_RELEASE);
+        count++;
+    }
+
+    uint32_t dropped = __atomic_load_n(&Dropped, __ATOMIC_RELAXED);
+    if (dropped != DroppedReported) {
+        int len = snprintf(line, sizeof(line), "W log: %lu lines dropped\r\n",
+                           (unsigned long)(dropped - DroppedReported));
+        Writer(line, len);
+        DroppedReported = dropped;
+    }
+    return count;
+}
+
+/******************************************************************************
+function: 1 if lines are waiting to be written out
+******************************************************************************/
+uint8_t Log_Pending(void)
+{
+    return __atomic_load_n(&Head, __ATOMIC_ACQUIRE) != __atomic_load_n(&Tail, __ATOMIC_ACQUIRE);
+}
+
+/******************************************************************************
+function: Lines dropped since start because the ring was full
+******************************************************************************/
+uint32_t Log_Dropped(void)
+{
+    return __atomic_load_n(&Dropped, __ATOMIC_RELAXED);
+}
+
+#ifdef ARDUINO
+static void Log_SerialWrite(const char *Text, uint16_t Len)
+{
+    Serial.write((const uint8_t *)Text, Len);
+}
+
+static void Log_Task(void *Param)
+{
+    for (;;) {
+        Log_Flush(Log_SerialWrite);
+        vTaskDelay(pdMS_TO_TICKS(LOG_FLUSH_MS));
+    }
+}
+
+/******************************************************************************
+function: Start the flush task, Serial must already be running
+info:
+    Lines logged before stay in the ring and are written out first.
+******************************************************************************/
+void Log_Start(void)
+{
+    xTaskCreate(Log_Task, "log", 3072, NULL, LOG_TASK_PRIORITY, NULL);
+}
+#endif
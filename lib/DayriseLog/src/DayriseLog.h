@@ -0,0 +1,88 @@
+/******************************************************************************
+* | File      	:   DayriseLog.h
+* | Function    :   Deferred logging for the alarm clock and the display
+* | Info        :
+*   Shared by the master (Alarm Clock/) and the display node (src/), installed
+*   and found like lib/DayriseProtocol.
+*
+*   LOG_ERROR() ... LOG_DEBUG() format the line into a slot of a ring buffer
+*   and return. A low priority task started by Log_Start() writes the slots
+*   to Serial. Writing a line never waits for the serial port: if the ring
+*   is full the line is dropped and counted.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-07-18
+* | Info        :
+*   Any number of tasks may log at the same time (a slot is claimed with a
+*   compare-and-swap on the head), there is one reader. Lines above
+*   LOG_LEVEL are removed by the preprocessor, arguments included.
+*   Not to be used from interrupt handlers.
+*
+******************************************************************************/
+#ifndef __DAYRISE_LOG_H
+#define __DAYRISE_LOG_H
+
+#include <stdint.h>
+
+/**
+ * Levels
+**/
+#define LOG_LEVEL_NONE      0
+#define LOG_LEVEL_ERROR     1
+#define LOG_LEVEL_WARN      2
+#define LOG_LEVEL_INFO      3
+#define LOG_LEVEL_DEBUG     4
+
+/**
+ * Highest level compiled in, e.g. build_flags = -DLOG_LEVEL=LOG_LEVEL_DEBUG
+**/
+#ifndef LOG_LEVEL
+#define LOG_LEVEL           LOG_LEVEL_INFO
+#endif
+
+/**
+ * Ring buffer
+**/
+#ifndef LOG_SLOTS
+#define LOG_SLOTS           32      // Power of two
+#endif
+#define LOG_LINE_SIZE       128     // Longer lines are cut
+#define LOG_FLUSH_MS        20      // Flush task period
+#define LOG_TASK_PRIORITY   1       // Above idle only
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...)      Log_Write(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...)      ((void)0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...)       Log_Write(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...)       ((void)0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...)       Log_Write(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...)       ((void)0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...)      Log_Write(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...)      ((void)0)
+#endif
+
+/**
+ * Output of Log_Flush(), Text is one finished line including "\r\n"
+**/
+typedef void (*LOG_WRITER)(const char *Text, uint16_t Len);
+
+void Log_Write(uint8_t Level, const char *Format, ...) __attribute__((format(printf, 2, 3)));
+uint16_t Log_Flush(LOG_WRITER Writer);
+uint8_t Log_Pending(void);
+uint32_t Log_Dropped(void);
+
+#ifdef ARDUINO
+void Log_Start(void);
+#endif
+
+#endif
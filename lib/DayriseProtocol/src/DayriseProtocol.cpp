@@ -0,0 +1,350 @@
+/******************************************************************************
+* | File      	:   DayriseProtocol.cpp
+* | Function    :   Framed UART protocol between alarm clock and display
+* | Info        :
+*   See DayriseProtocol.h
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-07-12
+* | Info        :
+*
+******************************************************************************/
+#include "DayriseProtocol.h"
+#include <string.h>
+
+/******************************************************************************
+function: CRC16-CCITT, four bits per step
+parameter:
+    Crc  : 0xFFFF for a new frame, or the result of the previous part
+******************************************************************************/
+uint16_t Protocol_Crc16(uint16_t Crc, const uint8_t *Data, uint16_t Len)
+{
+    static const uint16_t Table[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    };
+    for (uint16_t i = 0; i < Len; i++) {
+        Crc = (Crc << 4) ^ Table[(Crc >> 12) ^ (Data[i] >> 4)];
+        Crc = (Crc << 4) ^ Table[(Crc >> 12) ^ (Data[i] & 0x0F)];
+    }
+    return Crc;
+}
+
+/******************************************************************************
+function: Build a frame
+parameter:
+    Buffer  : Destination, PROTOCOL_FRAME_SIZE(Len) bytes
+    Size    : Size of the destination
+    Type    : Message type
+    Payload : Payload, may be NULL if Len is 0, or already in place at
+              Buffer + PROTOCOL_HEADER_SIZE
+    Len     : Payload length
+return: Frame length, 0 if it doesn't fit
+******************************************************************************/
+uint16_t Protocol_Encode(uint8_t *Buffer, uint16_t Size, uint8_t Type, const uint8_t *Payload, uint16_t Len)
+{
+    if (Len > PROTOCOL_MAX_PAYLOAD || Size < PROTOCOL_FRAME_SIZE(Len))
+        return 0;
+
+    Buffer[0] = PROTOCOL_SYNC;
+    Buffer[1] = Type;
+    Buffer[2] = Len & 0xFF;
+    Buffer[3] = Len >> 8;
+    if (Len > 0 && Payload != Buffer + PROTOCOL_HEADER_SIZE)
+        memcpy(Buffer + PROTOCOL_HEADER_SIZE, Payload, Len);
+    uint16_t Crc = Protocol_Crc16(0xFFFF, Buffer + 1, PROTOCOL_HEADER_SIZE - 1 + Len);
+    Buffer[PROTOCOL_HEADER_SIZE + Len] = Crc & 0xFF;
+    Buffer[PROTOCOL_HEADER_SIZE + Len + 1] = Crc >> 8;
+    return PROTOCOL_FRAME_SIZE(Len);
+}
+
+uint16_t Protocol_EncodeTime(uint8_t *Buffer, uint16_t Size, const PROTOCOL_TIME *Time)
+{
+    const uint8_t Payload[PROTOCOL_TIME_SIZE] = {
+        Time->Hour, Time->Min, Time->HasRemaining, Time->RemainingHour, Time->RemainingMin,
+    };
+    return Protocol_Encode(Buffer, Size, PROTOCOL_MSG_TIME, Payload, sizeof(Payload));
+}
+
+uint16_t Protocol_EncodeAlarm(uint8_t *Buffer, uint16_t Size, const PROTOCOL_ALARM *Alarm)
+{
+    const uint8_t Payload[PROTOCOL_ALARM_SIZE] = {Alarm->Hour, Alarm->Min, Alarm->State};
+    return Protocol_Encode(Buffer, Size, PROTOCOL_MSG_ALARM, Payload, sizeof(Payload));
+}
+
+/******************************************************************************
+function: Little endian fields of the telemetry payload
+******************************************************************************/
+static uint8_t *Protocol_Put32(uint8_t *Buffer, uint32_t Value)
+{
+    Buffer[0] = Value & 0xFF;
+    Buffer[1] = (Value >> 8) & 0xFF;
+    Buffer[2] = (Value >> 16) & 0xFF;
+    Buffer[3] = Value >> 24;
+    return Buffer + 4;
+}
+
+static const uint8_t *Protocol_Get32(const uint8_t *Buffer, uint32_t *Value)
+{
+    *Value = (uint32_t)Buffer[0] | ((uint32_t)Buffer[1] << 8) |
+             ((uint32_t)Buffer[2] << 16) | ((uint32_t)Buffer[3] << 24);
+    return Buffer + 4;
+}
+
+uint16_t Protocol_EncodeTelemetryRequest(uint8_t *Buffer, uint16_t Size, const PROTOCOL_TELEMETRY_REQUEST *Request)
+{
+    const uint8_t Payload[PROTOCOL_TELEMETRY_REQUEST_SIZE] = {
+        (uint8_t)(Request->Interval & 0xFF), (uint8_t)(Request->Interval >> 8),
+    };
+    return Protocol_Encode(Buffer, Size, PROTOCOL_MSG_TELEMETRY_REQUEST, Payload, sizeof(Payload));
+}
+
+uint16_t Protocol_EncodeTelemetry(uint8_t *Buffer, uint16_t Size, const PROTOCOL_TELEMETRY *Telemetry)
+{
+    uint8_t Payload[PROTOCOL_TELEMETRY_SIZE];
+    uint8_t *p = Payload;
+    p = Protocol_Put32(p, Telemetry->Frames);
+    p = Protocol_Put32(p, Telemetry->RenderUs);
+    p = Protocol_Put32(p, Telemetry->TransferUs);
+    p = Protocol_Put32(p, Telemetry->TransferBytes);
+    p = Protocol_Put32(p, Telemetry->RefreshUs);
+    p = Protocol_Put32(p, Telemetry->Skipped);
+    p = Protocol_Put32(p, Telemetry->Coalesced);
+    p = Protocol_Put32(p, Telemetry->QueueDrops);
+    p = Protocol_Put32(p, Telemetry->RxOverflows);
+    p = Protocol_Put32(p, Telemetry->RxErrors);
+    p = Protocol_Put32(p, Telemetry->FreeHeap);
+    Protocol_Put32(p, Telemetry->MinFreeHeap);
+    return Protocol_Encode(Buffer, Size, PROTOCOL_MSG_TELEMETRY, Payload, sizeof(Payload));
+}
+
+/******************************************************************************
+function: Build a PROTOCOL_MSG_REGION frame
+parameter:
+    Region : Position, size and flags
+    Data   : PackBits compressed rows of the region
+    Len    : Up to PROTOCOL_MAX_PAYLOAD - PROTOCOL_REGION_SIZE bytes
+return: Frame length, 0 if it doesn't fit
+info:
+    The payload is put together in place, Data is copied only once.
+******************************************************************************/
+uint16_t Protocol_EncodeRegion(uint8_t *Buffer, uint16_t Size, const PROTOCOL_REGION *Region, const uint8_t *Data, uint16_t Len)
+{
+    uint16_t PayloadLen = PROTOCOL_REGION_SIZE + Len;
+    if (Len > PROTOCOL_MAX_PAYLOAD - PROTOCOL_REGION_SIZE || Size < PROTOCOL_FRAME_SIZE(PayloadLen))
+        return 0;
+
+    uint8_t *p = Buffer + PROTOCOL_HEADER_SIZE;
+    const uint16_t Fields[4] = {Region->X, Region->Y, Region->W, Region->H};
+    for (uint8_t i = 0; i < 4; i++) {
+        *p++ = Fields[i] & 0xFF;
+        *p++ = Fields[i] >> 8;
+    }
+    *p++ = Region->Flags;
+    if (Len > 0)
+        memmove(p, Data, Len);
+    return Protocol_Encode(Buffer, Size, PROTOCOL_MSG_REGION, Buffer + PROTOCOL_HEADER_SIZE, PayloadLen);
+}
+
+/******************************************************************************
+function: Reset the parser and its counters
+******************************************************************************/
+void Protocol_Init(PROTOCOL_PARSER *Parser)
+{
+    memset(Parser, 0, sizeof(PROTOCOL_PARSER));
+}
+
+/******************************************************************************
+function: Drop the first Count stored bytes and search the rest for the next
+          sync byte
+parameter:
+    Count : Bytes to drop, 0 after an error (the bytes behind the bad sync
+            byte may hold the next frame), the frame length after a frame
+******************************************************************************/
+static void Protocol_Resync(PROTOCOL_PARSER *Parser, uint16_t Count)
+{
+    uint16_t i = Count;
+    while (i < Parser->Pending && Parser->Raw[i] != PROTOCOL_SYNC)
+        i++;
+    Parser->Stats.Skipped += i - Count;
+
+    if (i < Parser->Pending) {
+        Parser->Pending -= i + 1;
+        memmove(Parser->Raw, Parser->Raw + i + 1, Parser->Pending);
+        Parser->Synced = 1;
+    } else {
+        Parser->Pending = 0;
+        Parser->Synced = 0;
+    }
+    Parser->Count = 0;
+}
+
+/******************************************************************************
+function: Check the stored bytes one by one until they run out or the parser
+          loses the sync
+******************************************************************************/
+static void Protocol_Check(PROTOCOL_PARSER *Parser, PROTOCOL_HANDLER Handler, void *Arg)
+{
+    while (Parser->Synced && Parser->Count < Parser->Pending) {
+        Parser->Count++;
+        if (Parser->Count < PROTOCOL_HEADER_SIZE - 1)
+            continue;
+
+        uint16_t Len = Parser->Raw[1] | (Parser->Raw[2] << 8);
+        if (Len > PROTOCOL_MAX_PAYLOAD) {
+            Parser->Stats.LengthErrors++;
+            Protocol_Resync(Parser, 0);
+            continue;
+        }
+        if (Parser->Count < PROTOCOL_FRAME_SIZE(Len) - 1)
+            continue;
+
+        const uint8_t *Crc = Parser->Raw + PROTOCOL_HEADER_SIZE - 1 + Len;
+        if (Protocol_Crc16(0xFFFF, Parser->Raw, PROTOCOL_HEADER_SIZE - 1 + Len) != (Crc[0] | (Crc[1] << 8))) {
+            Parser->Stats.CrcErrors++;
+            Protocol_Resync(Parser, 0);
+            continue;
+        }
+
+        PROTOCOL_FRAME Frame;
+        Frame.Type = Parser->Raw[0];
+        Frame.Len = Len;
+        Frame.Payload = Parser->Raw + PROTOCOL_HEADER_SIZE - 1;
+        Parser->Stats.Frames++;
+        if (Handler != NULL)
+            Handler(Arg, &Frame);
+        Protocol_Resync(Parser, Parser->Count);
+    }
+}
+
+/******************************************************************************
+function: Feed received bytes to the parser
+parameter:
+    Data    : Received bytes, any split of the stream
+    Len     : Number of bytes
+    Handler : Called for every complete frame with a good CRC
+    Arg     : Passed to the handler
+******************************************************************************/
+void Protocol_Feed(PROTOCOL_PARSER *Parser, const uint8_t *Data, uint16_t Len, PROTOCOL_HANDLER Handler, void *Arg)
+{
+    for (uint16_t i = 0; i < Len; i++) {
+        if (!Parser->Synced) {
+            if (Data[i] == PROTOCOL_SYNC)
+                Parser->Synced = 1;
+            else
+                Parser->Stats.Skipped++;
+            continue;
+        }
+        //There is always room: a frame is complete or rejected at the latest
+        //when Raw is full
+        Parser->Raw[Parser->Pending++] = Data[i];
+        Protocol_Check(Parser, Handler, Arg);
+    }
+}
+
+/******************************************************************************
+function: The line has gone quiet
+info:
+    A sender writes a frame in one go, so a frame still incomplete now is
+    either damaged or never finishes. It is dropped and the bytes taken
+    after its sync byte are searched for frames again.
+******************************************************************************/
+void Protocol_Idle(PROTOCOL_PARSER *Parser, PROTOCOL_HANDLER Handler, void *Arg)
+{
+    while (Parser->Synced && Parser->Pending > 0) {
+        Parser->Stats.Incomplete++;
+        Protocol_Resync(Parser, 0);
+        Protocol_Check(Parser, Handler, Arg);
+    }
+}
+
+/******************************************************************************
+function: Payload of a PROTOCOL_MSG_TIME frame
+return: 1 if the frame is one
+******************************************************************************/
+uint8_t Protocol_DecodeTime(const PROTOCOL_FRAME *Frame, PROTOCOL_TIME *Time)
+{
+    if (Frame->Type != PROTOCOL_MSG_TIME || Frame->Len < PROTOCOL_TIME_SIZE)
+        return 0;
+    Time->Hour = Frame->Payload[0];
+    Time->Min = Frame->Payload[1];
+    Time->HasRemaining = Frame->Payload[2];
+    Time->RemainingHour = Frame->Payload[3];
+    Time->RemainingMin = Frame->Payload[4];
+    return 1;
+}
+
+/******************************************************************************
+function: Payload of a PROTOCOL_MSG_ALARM frame
+return: 1 if the frame is one
+******************************************************************************/
+uint8_t Protocol_DecodeAlarm(const PROTOCOL_FRAME *Frame, PROTOCOL_ALARM *Alarm)
+{
+    if (Frame->Type != PROTOCOL_MSG_ALARM || Frame->Len < PROTOCOL_ALARM_SIZE)
+        return 0;
+    Alarm->Hour = Frame->Payload[0];
+    Alarm->Min = Frame->Payload[1];
+    Alarm->State = Frame->Payload[2];
+    return 1;
+}
+
+/******************************************************************************
+function: Payload of a PROTOCOL_MSG_TELEMETRY_REQUEST frame
+return: 1 if the frame is one
+******************************************************************************/
+uint8_t Protocol_DecodeTelemetryRequest(const PROTOCOL_FRAME *Frame, PROTOCOL_TELEMETRY_REQUEST *Request)
+{
+    if (Frame->Type != PROTOCOL_MSG_TELEMETRY_REQUEST || Frame->Len < PROTOCOL_TELEMETRY_REQUEST_SIZE)
+        return 0;
+    Request->Interval = Frame->Payload[0] | (Frame->Payload[1] << 8);
+    return 1;
+}
+
+/******************************************************************************
+function: Payload of a PROTOCOL_MSG_TELEMETRY frame
+return: 1 if the frame is one
+******************************************************************************/
+uint8_t Protocol_DecodeTelemetry(const PROTOCOL_FRAME *Frame, PROTOCOL_TELEMETRY *Telemetry)
+{
+    if (Frame->Type != PROTOCOL_MSG_TELEMETRY || Frame->Len < PROTOCOL_TELEMETRY_SIZE)
+        return 0;
+    const uint8_t *p = Frame->Payload;
+    p = Protocol_Get32(p, &Telemetry->Frames);
+    p = Protocol_Get32(p, &Telemetry->RenderUs);
+    p = Protocol_Get32(p, &Telemetry->TransferUs);
+    p = Protocol_Get32(p, &Telemetry->TransferBytes);
+    p = Protocol_Get32(p, &Telemetry->RefreshUs);
+    p = Protocol_Get32(p, &Telemetry->Skipped);
+    p = Protocol_Get32(p, &Telemetry->Coalesced);
+    p = Protocol_Get32(p, &Telemetry->QueueDrops);
+    p = Protocol_Get32(p, &Telemetry->RxOverflows);
+    p = Protocol_Get32(p, &Telemetry->RxErrors);
+    p = Protocol_Get32(p, &Telemetry->FreeHeap);
+    Protocol_Get32(p, &Telemetry->MinFreeHeap);
+    return 1;
+}
+
+/******************************************************************************
+function: Header and image data of a PROTOCOL_MSG_REGION frame
+parameter:
+    Data : Set to the compressed rows inside the frame
+    Len  : Set to their length
+return: 1 if the frame is one
+info:
+    Only the frame is checked, the region itself must be checked against
+    the framebuffer by the receiver.
+******************************************************************************/
+uint8_t Protocol_DecodeRegion(const PROTOCOL_FRAME *Frame, PROTOCOL_REGION *Region, const uint8_t **Data, uint16_t *Len)
+{
+    if (Frame->Type != PROTOCOL_MSG_REGION || Frame->Len < PROTOCOL_REGION_SIZE)
+        return 0;
+    const uint8_t *p = Frame->Payload;
+    Region->X = p[0] | (p[1] << 8);
+    Region->Y = p[2] | (p[3] << 8);
+    Region->W = p[4] | (p[5] << 8);
+    Region->H = p[6] | (p[7] << 8);
+    Region->Flags = p[8];
+    *Data = p + PROTOCOL_REGION_SIZE;
+    *Len = Frame->Len - PROTOCOL_REGION_SIZE;
+    return 1;
+}
@@ -0,0 +1,182 @@
+/******************************************************************************
+* | File      	:   DayriseProtocol.h
+* | Function    :   Framed UART protocol between alarm clock and display
+* | Info        :
+*   Shared by the master (Alarm Clock/) and the display node (src/). In the
+*   Arduino IDE the folder lib/DayriseProtocol is installed as a library,
+*   PlatformIO picks it up from lib/ by itself.
+*
+*   Frame, multi-byte fields little endian:
+*     0xA5 | Type | Len (2) | Payload (Len) | CRC16 (2)
+*   The CRC is CRC16-CCITT (polynomial 0x1021, start value 0xFFFF) over
+*   type, length and payload.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-07-12
+* | Info        :
+*   The parser takes the stream in pieces of any size and needs no heap.
+*   After a bad length or CRC it searches the bytes it has already taken
+*   for the next sync byte, so a frame following a damaged one is not lost.
+*   A damaged length can make the parser wait for bytes that never come,
+*   Protocol_Idle() resolves that once the line has gone quiet.
+*
+******************************************************************************/
+#ifndef __DAYRISE_PROTOCOL_H
+#define __DAYRISE_PROTOCOL_H
+
+#include <stdint.h>
+
+/**
+ * Frame layout
+**/
+#define PROTOCOL_SYNC           0xA5
+#define PROTOCOL_HEADER_SIZE    4       // Sync, type, length
+#define PROTOCOL_CRC_SIZE       2
+#define PROTOCOL_FRAME_SIZE(Len) (PROTOCOL_HEADER_SIZE + (Len) + PROTOCOL_CRC_SIZE)
+
+/**
+ * The display sleeps between updates and wakes up on the first falling edge
+ * of its RX line, the byte carrying that edge is lost. A sender writes
+ * PROTOCOL_WAKE and waits PROTOCOL_WAKE_MS before the frame. The parser
+ * skips the wake byte like any other byte outside a frame.
+**/
+#define PROTOCOL_WAKE           0x00
+#define PROTOCOL_WAKE_MS        3
+
+/**
+ * Longest payload the parser accepts. One PROTOCOL_MSG_REGION frame carries
+ * up to PROTOCOL_MAX_PAYLOAD - PROTOCOL_REGION_SIZE bytes of image data.
+**/
+#ifndef PROTOCOL_MAX_PAYLOAD
+#define PROTOCOL_MAX_PAYLOAD    256
+#endif
+
+/**
+ * Message types
+**/
+#define PROTOCOL_MSG_TIME       0x01    // Current time, replaces "0|hh:mm|hh:mm"
+#define PROTOCOL_MSG_ALARM      0x02    // Alarm being set, replaces "1|hh:mm|state"
+#define PROTOCOL_MSG_TELEMETRY_REQUEST  0x03    // Master asks the display for PROTOCOL_MSG_TELEMETRY
+#define PROTOCOL_MSG_REGION     0x04    // Compressed part of the framebuffer, drawn as it is
+#define PROTOCOL_MSG_TELEMETRY  0x81    // Display to master, health of the display node
+
+/**
+ * Payload of PROTOCOL_MSG_TIME
+**/
+typedef struct {
+    uint8_t Hour;
+    uint8_t Min;
+    uint8_t HasRemaining;   // 0: no alarm active, the display shows "-"
+    uint8_t RemainingHour;  // Time left until the alarm
+    uint8_t RemainingMin;
+} PROTOCOL_TIME;
+#define PROTOCOL_TIME_SIZE      5
+
+/**
+ * Payload of PROTOCOL_MSG_ALARM
+**/
+typedef struct {
+    uint8_t Hour;
+    uint8_t Min;
+    uint8_t State;          // 0 = being edited, 1 = set
+} PROTOCOL_ALARM;
+#define PROTOCOL_ALARM_SIZE     3
+
+/**
+ * Payload of PROTOCOL_MSG_TELEMETRY_REQUEST
+**/
+typedef struct {
+    uint16_t Interval;      // Seconds between reports, 0 = this report only
+} PROTOCOL_TELEMETRY_REQUEST;
+#define PROTOCOL_TELEMETRY_REQUEST_SIZE 2
+
+/**
+ * Header of PROTOCOL_MSG_REGION, followed by the PackBits compressed rows of
+ * the region (see tools/assets.py packbits()) up to the end of the payload.
+ * Coordinates are framebuffer coordinates, before any rotation: 1 bit per
+ * pixel, MSB first, 0 = black. X and W are multiples of 8. A region larger
+ * than one frame is sent as bands, only the last one sets
+ * PROTOCOL_REGION_REFRESH.
+**/
+typedef struct {
+    uint16_t X;
+    uint16_t Y;
+    uint16_t W;
+    uint16_t H;
+    uint8_t Flags;
+} PROTOCOL_REGION;
+#define PROTOCOL_REGION_SIZE    9
+#define PROTOCOL_REGION_REFRESH 0x01    // Show everything received so far
+
+/**
+ * Payload of PROTOCOL_MSG_TELEMETRY, counters since the display started
+**/
+typedef struct {
+    uint32_t Frames;        // Frames shown on the panel
+    uint32_t RenderUs;      // Last frame: drawing into the framebuffer
+    uint32_t TransferUs;    // Last frame: SPI transfer to the panel
+    uint32_t TransferBytes; // All SPI transfers of frames
+    uint32_t RefreshUs;     // Last frame: panel refresh
+    uint32_t Skipped;       // Messages that didn't change the screen
+    uint32_t Coalesced;     // Messages overtaken by a newer one before drawing
+    uint32_t QueueDrops;    // Messages dropped because the queue was full
+    uint32_t RxOverflows;   // UART FIFO overflows and full driver buffer
+    uint32_t RxErrors;      // CRC, length and line errors
+    uint32_t FreeHeap;
+    uint32_t MinFreeHeap;
+} PROTOCOL_TELEMETRY;
+#define PROTOCOL_TELEMETRY_SIZE 48
+
+/**
+ * A received frame, only valid during the handler call
+**/
+typedef struct {
+    uint8_t Type;
+    uint16_t Len;
+    const uint8_t *Payload;
+} PROTOCOL_FRAME;
+
+typedef void (*PROTOCOL_HANDLER)(void *Arg, const PROTOCOL_FRAME *Frame);
+
+/**
+ * Parser counters
+**/
+typedef struct {
+    uint32_t Frames;        // Good frames
+    uint32_t CrcErrors;
+    uint32_t LengthErrors;  // Length above PROTOCOL_MAX_PAYLOAD
+    uint32_t Skipped;       // Bytes thrown away while searching for a sync byte
+    uint32_t Incomplete;    // Frames cut off by Protocol_Idle()
+} PROTOCOL_STATS;
+
+/**
+ * Incremental parser. Raw holds the bytes after the sync byte: Pending of
+ * them are stored, the first Count belong to the frame checked so far.
+**/
+typedef struct {
+    uint8_t Synced;
+    uint16_t Count;
+    uint16_t Pending;
+    uint8_t Raw[PROTOCOL_FRAME_SIZE(PROTOCOL_MAX_PAYLOAD) - 1];
+    PROTOCOL_STATS Stats;
+} PROTOCOL_PARSER;
+
+uint16_t Protocol_Crc16(uint16_t Crc, const uint8_t *Data, uint16_t Len);
+
+uint16_t Protocol_Encode(uint8_t *Buffer, uint16_t Size, uint8_t Type, const uint8_t *Payload, uint16_t Len);
+uint16_t Protocol_EncodeTime(uint8_t *Buffer, uint16_t Size, const PROTOCOL_TIME *Time);
+uint16_t Protocol_EncodeAlarm(uint8_t *Buffer, uint16_t Size, const PROTOCOL_ALARM *Alarm);
+uint16_t Protocol_EncodeTelemetryRequest(uint8_t *Buffer, uint16_t Size, const PROTOCOL_TELEMETRY_REQUEST *Request);
+uint16_t Protocol_EncodeTelemetry(uint8_t *Buffer, uint16_t Size, const PROTOCOL_TELEMETRY *Telemetry);
+uint16_t Protocol_EncodeRegion(uint8_t *Buffer, uint16_t Size, const PROTOCOL_REGION *Region, const uint8_t *Data, uint16_t Len);
+
+void Protocol_Init(PROTOCOL_PARSER *Parser);
+void Protocol_Feed(PROTOCOL_PARSER *Parser, const uint8_t *Data, uint16_t Len, PROTOCOL_HANDLER Handler, void *Arg);
+void Protocol_Idle(PROTOCOL_PARSER *Parser, PROTOCOL_HANDLER Handler, void *Arg);
+uint8_t Protocol_DecodeTime(const PROTOCOL_FRAME *Frame, PROTOCOL_TIME *Time);
+uint8_t Protocol_DecodeAlarm(const PROTOCOL_FRAME *Frame, PROTOCOL_ALARM *Alarm);
+uint8_t Protocol_DecodeTelemetryRequest(const PROTOCOL_FRAME *Frame, PROTOCOL_TELEMETRY_REQUEST *Request);
+uint8_t Protocol_DecodeTelemetry(const PROTOCOL_FRAME *Frame, PROTOCOL_TELEMETRY *Telemetry);
+uint8_t Protocol_DecodeRegion(const PROTOCOL_FRAME *Frame, PROTOCOL_REGION *Region, const uint8_t **Data, uint16_t *Len);
+
+#endif
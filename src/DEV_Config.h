@@ -30,7 +30,11 @@
 #ifndef _DEV_CONFIG_H_
 #define _DEV_CONFIG_H_
 
+#ifdef ARDUINO
 #include <Arduino.h>
+#else
+#include <unistd.h>     // Host build (PlatformIO native), see platformio.ini
+#endif
 #include <stdint.h>
 #include <stdio.h>
 
@@ -57,13 +61,22 @@
 /**
  * GPIO read and write
 **/
+#ifdef ARDUINO
 #define DEV_Digital_Write(_pin, _value) digitalWrite(_pin, _value == 0? LOW:HIGH)
 #define DEV_Digital_Read(_pin) digitalRead(_pin)
+#else
+#define DEV_Digital_Write(_pin, _value)
+#define DEV_Digital_Read(_pin) 1
+#endif
 
 /**
  * delay x ms
 **/
+#ifdef ARDUINO
 #define DEV_Delay_ms(__xms) delay(__xms)
+#else
+#define DEV_Delay_ms(__xms) usleep((__xms) * 1000)
+#endif
 
 /*------------------------------------------------------------------------------------------------------*/
 UBYTE DEV_Module_Init(void);
@@ -0,0 +1,136 @@
+/******************************************************************************
+* | File      	:   GUI_Atlas.cpp
+* | Function    :   Anti-aliased text from 2 bpp glyph atlases
+* | Info        :
+*   See GUI_Atlas.h
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-07-05
+* | Info        :
+*
+******************************************************************************/
+#include "GUI_Atlas.h"
+
+#define ATLAS_LANES     0x33333333      // Every other 2 bit pixel, one per 4 bit lane
+#define ATLAS_GUARD     0x44444444      // Free bit above each lane
+
+typedef enum {
+    ATLAS_DARKEN,       // Black ink, background kept
+    ATLAS_LIGHTEN,      // White ink, background kept
+    ATLAS_WHITE_ON_BLACK,
+} ATLAS_MODE;
+
+/******************************************************************************
+function: Pixel-wise maximum of 16 pixels of 2 bits
+info:
+    Even and odd pixels are compared in 4 bit lanes, (a | guard) - b keeps the
+    guard bit exactly where a >= b and never borrows from the next lane.
+******************************************************************************/
+static inline UDOUBLE GrayAtlas_Max(UDOUBLE a, UDOUBLE b)
+{
+    UDOUBLE r = 0;
+    for (UBYTE s = 0; s < 4; s += 2) {
+        UDOUBLE x = (a >> s) & ATLAS_LANES, y = (b >> s) & ATLAS_LANES;
+        UDOUBLE ge = ((((x | ATLAS_GUARD) - y) & ATLAS_GUARD) >> 2) * 3;
+        r |= ((x & ge) | (y & ~ge)) << s;
+    }
+    return r;
+}
+
+//Pixels first..last-1 of a word of 16 pixels
+static inline UDOUBLE GrayAtlas_Cover(int first, int last)
+{
+    if (first < 0)
+        first = 0;
+    if (last > 16)
+        last = 16;
+    if (first >= last)
+        return 0;
+    UDOUBLE head = 0xFFFFFFFF >> (2 * first);
+    UDOUBLE tail = (last == 16) ? 0 : 0xFFFFFFFF >> (2 * last);
+    return head & ~tail;
+}
+
+//Up to 4 bytes, the first one in the highest bits
+static inline UDOUBLE GrayAtlas_Load(const UBYTE *p, UBYTE n)
+{
+    UDOUBLE w = 0;
+    for (UBYTE i = 0; i < 4; i++)
+        w = (w << 8) | (i < n ? p[i] : 0);
+    return w;
+}
+
+static inline void GrayAtlas_Store(UBYTE *p, UDOUBLE w, UBYTE n)
+{
+    for (UBYTE i = 0; i < n; i++)
+        p[i] = w >> (24 - 8 * i);
+}
+
+/******************************************************************************
+function: Draw a character from a glyph atlas
+parameter:
+    See PaintCtx_DrawChar(), Font is the atlas
+return: 1 if the character was drawn, 0 if the caller has to draw it
+info:
+    Framebuffer values are 3 = white ... 0 = black (WHITE % 4, BLACK % 4), so
+    black ink is the maximum of coverage and 3 - value.
+******************************************************************************/
+UBYTE GrayAtlas_DrawChar(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
+                         const sFONT_GRAY* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    const sFONT *Mono = Font->Mono;
+    if (Ctx->Scale != 4 || Ctx->Rotate != Font->Rotate || Ctx->Mirror != MIRROR_NONE)
+        return 0;
+    if ((UBYTE)Acsii_Char < Font->First || (UBYTE)Acsii_Char > Font->Last)
+        return 0;
+    if ((UDOUBLE)Xpoint + Mono->Width > Ctx->Width || (UDOUBLE)Ypoint + Mono->Height > Ctx->Height)
+        return 0;
+
+    ATLAS_MODE Mode;
+    if (Color_Background == FONT_BACKGROUND && Color_Foreground == BLACK)
+        Mode = ATLAS_DARKEN;
+    else if (Color_Background == FONT_BACKGROUND && Color_Foreground == WHITE)
+        Mode = ATLAS_LIGHTEN;
+    else if (Color_Foreground == WHITE && Color_Background == BLACK)
+        Mode = ATLAS_WHITE_ON_BLACK;
+    else
+        return 0;
+
+    UWORD Xa, Ya, Xb, Yb;
+    if (!PaintCtx_MapPoint(Ctx, Xpoint, Ypoint, &Xa, &Ya) ||
+        !PaintCtx_MapPoint(Ctx, Xpoint + Mono->Width - 1, Ypoint + Mono->Height - 1, &Xb, &Yb))
+        return 0;
+    UWORD X0 = Xa < Xb ? Xa : Xb, X1 = Xa < Xb ? Xb : Xa;
+    UWORD Y0 = Ya < Yb ? Ya : Yb;
+
+    UBYTE phase = X0 % 4;
+    UWORD Bits = X1 - X0 + 1;
+    UWORD Bytes = (phase + Bits + 3) / 4;
+    const UBYTE *src = Font->table + ((UBYTE)Acsii_Char - Font->First) * (UDOUBLE)Font->Rows * Font->WidthByte;
+    UBYTE *dst = Ctx->Image + X0 / 4 + (UDOUBLE)Y0 * Ctx->WidthByte;
+
+    for (UWORD Row = 0; Row < Font->Rows; Row++) {
+        UDOUBLE carry = 0;
+        for (UWORD i = 0; i < Bytes; i += 4) {
+            //Atlas lines are whole words, past their end only the carry is left
+            UDOUBLE s = (i < Font->WidthByte) ? GrayAtlas_Load(src + i, 4) : 0;
+            UDOUBLE ink = phase ? (carry << (32 - 2 * phase)) | (s >> (2 * phase)) : s;
+            carry = s;
+
+            UBYTE n = (Bytes - i < 4) ? Bytes - i : 4;
+            UDOUBLE d = GrayAtlas_Load(dst + i, n);
+            if (Mode == ATLAS_DARKEN) {
+                d = ~GrayAtlas_Max(~d, ink);
+            } else if (Mode == ATLAS_LIGHTEN) {
+                d = GrayAtlas_Max(d, ink);
+            } else {
+                UDOUBLE cover = GrayAtlas_Cover(phase - 4 * i, phase + Bits - 4 * i);
+                d = (d & ~cover) | (ink & cover);
+            }
+            GrayAtlas_Store(dst + i, d, n);
+        }
+        src += Font->WidthByte;
+        dst += Ctx->WidthByte;
+    }
+    return 1;
+}
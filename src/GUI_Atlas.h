@@ -0,0 +1,29 @@
+/******************************************************************************
+* | File      	:   GUI_Atlas.h
+* | Function    :   Anti-aliased text from 2 bpp glyph atlases
+* | Info        :
+*   A glyph atlas (sFONT_GRAY, see fonts.h) holds the ink coverage of every
+*   glyph already in the layout of a scale 4 framebuffer. A glyph is blitted
+*   16 pixels at a time: the atlas line is shifted to the pixel position and
+*   merged into the framebuffer word with lane-wise max/min.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-07-05
+* | Info        :
+*   Only scale 4 canvases with the atlas' rotation and no mirroring are
+*   blitted, black or white ink on the kept background (FONT_BACKGROUND) or
+*   white ink on black. All other cases fall back to the 1-bpp font of the
+*   atlas.
+*
+******************************************************************************/
+#ifndef __GUI_ATLAS_H
+#define __GUI_ATLAS_H
+
+#include "DEV_Config.h"
+#include "fonts/fonts.h"
+#include "GUI_Paint.h"
+
+UBYTE GrayAtlas_DrawChar(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
+                         const sFONT_GRAY* Font, UWORD Color_Foreground, UWORD Color_Background);
+
+#endif
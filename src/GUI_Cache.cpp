@@ -0,0 +1,207 @@
+/******************************************************************************
+* | File      	:   GUI_Cache.cpp
+* | Function    :   Sprite cache for font glyphs
+* | Info        :
+*   See GUI_Cache.h
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-06-20
+* | Info        :
+*
+******************************************************************************/
+#include "GUI_Cache.h"
+#include <stdlib.h>
+#include <string.h>
+
+/******************************************************************************
+function: Enable the cache
+parameter:
+    Cache  : Cache to set up, must be zeroed before the first call
+    budget : Maximum number of bytes used by all sprites, 0 disables the cache
+******************************************************************************/
+void GlyphCache_Init(GLYPH_CACHE *Cache, UDOUBLE budget)
+{
+    GlyphCache_Flush(Cache);
+    memset(&Cache->Stats, 0, sizeof(Cache->Stats));
+    Cache->Budget = budget;
+    Cache->Tick = 0;
+}
+
+static void GlyphCache_Evict(GLYPH_CACHE *Cache, GLYPH_SPRITE *sprite)
+{
+    Cache->Stats.Bytes -= (UDOUBLE)sprite->WidthByte * sprite->Rows;
+    free(sprite->Data);
+    memset(sprite, 0, sizeof(GLYPH_SPRITE));
+}
+
+/******************************************************************************
+function: Drop all sprites
+******************************************************************************/
+void GlyphCache_Flush(GLYPH_CACHE *Cache)
+{
+    for (UWORD i = 0; i < GLYPH_CACHE_ENTRIES; i++) {
+        if (Cache->Sprites[i].Data != NULL)
+            GlyphCache_Evict(Cache, &Cache->Sprites[i]);
+    }
+}
+
+void GlyphCache_GetStats(const GLYPH_CACHE *Cache, GLYPH_CACHE_STATS *stats)
+{
+    *stats = Cache->Stats;
+}
+
+/******************************************************************************
+function: Find a free entry, evicting least recently used sprites until the
+          entry and the requested number of bytes fit into the budget
+parameter:
+    size : Bytes needed by the new sprite
+******************************************************************************/
+static GLYPH_SPRITE *GlyphCache_Alloc(GLYPH_CACHE *Cache, UDOUBLE size)
+{
+    if (size > Cache->Budget)
+        return NULL;
+
+    for (;;) {
+        GLYPH_SPRITE *free_entry = NULL, *oldest = NULL;
+        for (UWORD i = 0; i < GLYPH_CACHE_ENTRIES; i++) {
+            if (Cache->Sprites[i].Data == NULL) {
+                if (free_entry == NULL)
+                    free_entry = &Cache->Sprites[i];
+            } else if (oldest == NULL || Cache->Sprites[i].LastUse < oldest->LastUse) {
+                oldest = &Cache->Sprites[i];
+            }
+        }
+        if (free_entry != NULL && Cache->Stats.Bytes + size <= Cache->Budget) {
+            free_entry->Data = (UBYTE *)calloc(size, 1);
+            if (free_entry->Data == NULL)
+                return NULL;
+            Cache->Stats.Bytes += size;
+            return free_entry;
+        }
+        if (oldest == NULL)
+            return NULL;
+        GlyphCache_Evict(Cache, oldest);
+        Cache->Stats.Evictions++;
+    }
+}
+
+/******************************************************************************
+function: Rasterize a glyph into the framebuffer layout
+parameter:
+    Xpoint, Ypoint : Canvas position the glyph is drawn at
+    X0, Y0         : Framebuffer position of the glyph's top left byte corner
+******************************************************************************/
+static GLYPH_SPRITE *GlyphCache_Render(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, UWORD X0, UWORD Y0,
+                                       UWORD X1, UWORD Y1, const char Acsii_Char, sFONT* Font)
+{
+    UBYTE phase = X0 % 8;
+    UWORD bits = X1 - X0 + 1;
+    UWORD rows = Y1 - Y0 + 1;
+    UWORD width_byte = (phase + bits + 7) / 8;
+
+    GLYPH_SPRITE *sprite = GlyphCache_Alloc(Ctx->Cache, (UDOUBLE)width_byte * rows);
+    if (sprite == NULL)
+        return NULL;
+
+    sprite->Font = Font;
+    sprite->Acsii_Char = Acsii_Char;
+    sprite->Rotate = Ctx->Rotate;
+    sprite->Mirror = Ctx->Mirror;
+    sprite->Phase = phase;
+    sprite->Bits = bits;
+    sprite->Rows = rows;
+    sprite->WidthByte = width_byte;
+
+    UWORD Font_WidthByte = Font->Width / 8 + (Font->Width % 8 ? 1 : 0);
+    const unsigned char *ptr = &Font->table[Font_GlyphIndex(Font, Acsii_Char) * Font->Height * Font_WidthByte];
+    for (UWORD Page = 0; Page < Font->Height; Page++) {
+        for (UWORD Column = 0; Column < Font->Width; Column++) {
+            if (ptr[Page * Font_WidthByte + Column / 8] & (0x80 >> (Column % 8))) {
+                UWORD X, Y;
+                PaintCtx_MapPoint(Ctx, Xpoint + Column, Ypoint + Page, &X, &Y);
+                X = X - X0 + phase;
+                Y = Y - Y0;
+                sprite->Data[Y * width_byte + X / 8] |= 0x80 >> (X % 8);
+            }
+        }
+    }
+    return sprite;
+}
+
+/******************************************************************************
+function: Draw a character from the cache
+parameter:
+    See PaintCtx_DrawChar()
+return: 1 if the character was drawn, 0 if the caller has to draw it
+info:
+    Only glyphs lying completely on a 1-bpp canvas are cached, everything
+    else keeps the exact behaviour of the pixel by pixel path.
+******************************************************************************/
+UBYTE GlyphCache_DrawChar(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
+                          sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    GLYPH_CACHE *Cache = Ctx->Cache;
+    if (Cache == NULL || Cache->Budget == 0 || Ctx->Scale != 2 || Font_GlyphIndex(Font, Acsii_Char) < 0)
+        return 0;
+    if ((UDOUBLE)Xpoint + Font->Width > Ctx->Width || (UDOUBLE)Ypoint + Font->Height > Ctx->Height)
+        return 0;
+
+    UWORD Xa, Ya, Xb, Yb;
+    if (!PaintCtx_MapPoint(Ctx, Xpoint, Ypoint, &Xa, &Ya) ||
+        !PaintCtx_MapPoint(Ctx, Xpoint + Font->Width - 1, Ypoint + Font->Height - 1, &Xb, &Yb))
+        return 0;
+    UWORD X0 = Xa < Xb ? Xa : Xb, X1 = Xa < Xb ? Xb : Xa;
+    UWORD Y0 = Ya < Yb ? Ya : Yb, Y1 = Ya < Yb ? Yb : Ya;
+    UBYTE phase = X0 % 8;
+
+    GLYPH_SPRITE *sprite = NULL;
+    for (UWORD i = 0; i < GLYPH_CACHE_ENTRIES; i++) {
+        GLYPH_SPRITE *s = &Cache->Sprites[i];
+        if (s->Data != NULL && s->Font == Font && s->Acsii_Char == Acsii_Char &&
+            s->Phase == phase && s->Rotate == Ctx->Rotate && s->Mirror == Ctx->Mirror) {
+            sprite = s;
+            break;
+        }
+    }
+    if (sprite == NULL) {
+        Cache->Stats.Misses++;
+        sprite = GlyphCache_Render(Ctx, Xpoint, Ypoint, X0, Y0, X1, Y1, Acsii_Char, Font);
+        if (sprite == NULL)
+            return 0;
+    } else {
+        Cache->Stats.Hits++;
+    }
+    sprite->LastUse = ++Cache->Tick;
+
+    UBYTE first = 0xFF >> phase;
+    UBYTE tail = (phase + sprite->Bits) % 8;
+    UBYTE last = tail ? (UBYTE)(0xFF << (8 - tail)) : 0xFF;
+    UWORD n = sprite->WidthByte;
+    UBYTE fg = (Color_Foreground == BLACK) ? 0x00 : 0xFF;
+    UBYTE bg = (Color_Background == BLACK) ? 0x00 : 0xFF;
+    const UBYTE *src = sprite->Data;
+    UBYTE *dst = Ctx->Image + X0 / 8 + (UDOUBLE)Y0 * Ctx->WidthByte;
+
+    for (UWORD Row = 0; Row < sprite->Rows; Row++) {
+        if (FONT_BACKGROUND == Color_Background) {
+            //Only the ink is written, like the pixel by pixel path
+            if (fg)
+                for (UWORD i = 0; i < n; i++) dst[i] |= src[i];
+            else
+                for (UWORD i = 0; i < n; i++) dst[i] &= ~src[i];
+        } else {
+            for (UWORD i = 0; i < n; i++) {
+                UBYTE cover = 0xFF;
+                if (i == 0)
+                    cover &= first;
+                if (i == n - 1)
+                    cover &= last;
+                UBYTE value = (fg & src[i]) | (bg & ~src[i]);
+                dst[i] = (dst[i] & ~cover) | (value & cover);
+            }
+        }
+        src += n;
+        dst += Ctx->WidthByte;
+    }
+    return 1;
+}
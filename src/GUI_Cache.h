@@ -0,0 +1,74 @@
+/******************************************************************************
+* | File      	:   GUI_Cache.h
+* | Function    :   Sprite cache for font glyphs
+* | Info        :
+*   Every glyph is rasterized once into the layout of the framebuffer (same
+*   rotation, mirroring and bit position inside the byte). Later draws of the
+*   same glyph at the same bit position are plain masked byte copies instead
+*   of one Paint_SetPixel() per pixel.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-06-20
+* | Info        :
+*   Entries are evicted least recently used first, once either the entry
+*   table or the byte budget given to GlyphCache_Init() is exhausted.
+*   A cache is attached to a PaintContext with PaintCtx_SetGlyphCache(). It
+*   is not locked, so contexts drawn from different tasks need their own.
+*
+******************************************************************************/
+#ifndef __GUI_CACHE_H
+#define __GUI_CACHE_H
+
+#include "DEV_Config.h"
+#include "fonts/fonts.h"
+#include "GUI_Paint.h"
+
+/**
+ * Cache limits
+**/
+#define GLYPH_CACHE_ENTRIES     64              // 2 x (11 FontRoboto72 + 21 FontRoboto13 glyphs of the screens)
+#define GLYPH_CACHE_BUDGET      (20 * 1024)     // 2 x 11 x 754 B of FontRoboto72 + 2 x ~700 B of FontRoboto13, about 18 KB
+
+/**
+ * A pre-rendered glyph
+**/
+typedef struct {
+    const sFONT *Font;
+    char Acsii_Char;
+    UWORD Rotate;
+    UWORD Mirror;
+    UBYTE Phase;        // Bit position of the first column inside its byte
+    UWORD Bits;         // Pixels per sprite row
+    UWORD Rows;         // Sprite rows = framebuffer lines
+    UWORD WidthByte;    // Bytes per sprite row
+    UDOUBLE LastUse;
+    UBYTE *Data;        // Ink mask, 1 = glyph pixel
+} GLYPH_SPRITE;
+
+/**
+ * Cache counters
+**/
+typedef struct {
+    UDOUBLE Hits;
+    UDOUBLE Misses;
+    UDOUBLE Evictions;
+    UDOUBLE Bytes;
+} GLYPH_CACHE_STATS;
+
+/**
+ * Cache instance, declared as GLYPH_CACHE in GUI_Paint.h
+**/
+struct _tGlyphCache {
+    GLYPH_SPRITE Sprites[GLYPH_CACHE_ENTRIES];
+    GLYPH_CACHE_STATS Stats;
+    UDOUBLE Budget;
+    UDOUBLE Tick;
+};
+
+void GlyphCache_Init(GLYPH_CACHE *Cache, UDOUBLE Budget);
+void GlyphCache_Flush(GLYPH_CACHE *Cache);
+void GlyphCache_GetStats(const GLYPH_CACHE *Cache, GLYPH_CACHE_STATS *Stats);
+UBYTE GlyphCache_DrawChar(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
+                          sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+
+#endif
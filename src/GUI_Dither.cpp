@@ -0,0 +1,155 @@
+/******************************************************************************
+* | File      	:   GUI_Dither.cpp
+* | Function    :   Dithering of 8-bit grayscale images into the framebuffer
+* | Info        :
+*   See GUI_Dither.h
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-07-07
+* | Info        :
+*   Same methods as tools/assets.py --dither, in integer arithmetic.
+*
+******************************************************************************/
+#include "GUI_Dither.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const UBYTE Dither_Bayer8[8][8] = {
+    { 0, 32,  8, 40,  2, 34, 10, 42},
+    {48, 16, 56, 24, 50, 18, 58, 26},
+    {12, 44,  4, 36, 14, 46,  6, 38},
+    {60, 28, 52, 20, 62, 30, 54, 22},
+    { 3, 35, 11, 43,  1, 33,  9, 41},
+    {51, 19, 59, 27, 49, 17, 57, 25},
+    {15, 47,  7, 39, 13, 45,  5, 37},
+    {63, 31, 55, 23, 61, 29, 53, 21},
+};
+
+//Canvas color of a level, 0 = black ... Steps = white
+static UWORD Dither_Color(UBYTE Scale, UBYTE Level)
+{
+    if (Scale == 2)
+        return Level ? WHITE : BLACK;
+    return Level;
+}
+
+/******************************************************************************
+function: Start dithering an image
+parameter:
+    Dither  : State of the image
+    Ctx     : Canvas drawn into, scale 2 or 4
+    Xstart  : Canvas position of the top left pixel
+    Ystart  :
+    Width   : Source pixels per row
+    Height  : Source rows
+    Mode    : Dithering method
+    Scratch : DITHER_SCRATCH(Width) int16_t for DITHER_FLOYD_STEINBERG,
+              may be NULL otherwise
+******************************************************************************/
+void Dither_Begin(DITHER *Dither, PaintContext *Ctx, UWORD Xstart, UWORD Ystart, UWORD Width, UWORD Height,
+                  DITHER_MODE Mode, int16_t *Scratch)
+{
+    Dither->Ctx = Ctx;
+    Dither->Xstart = Xstart;
+    Dither->Ystart = Ystart;
+    Dither->Width = Width;
+    Dither->Height = Height;
+    Dither->Row = 0;
+    Dither->Mode = Mode;
+    Dither->Error = Scratch;
+    if (Mode == DITHER_FLOYD_STEINBERG) {
+        if (Scratch == NULL) {
+            Debug("Dither_Begin: Floyd-Steinberg needs scratch memory\r\n");
+            Dither->Mode = DITHER_NONE;
+        } else {
+            memset(Scratch, 0, DITHER_SCRATCH(Width) * sizeof(int16_t));
+        }
+    }
+}
+
+/******************************************************************************
+function: Dither the next source row
+parameter:
+    Gray : Width pixels, 0 = black ... 255 = white
+return: 1 while more rows are expected, 0 after the last row
+info:
+    Floyd-Steinberg keeps the error in 1/16 gray steps in two rows: the
+    current one (7/16 to the right) and the next one (3/16, 5/16, 1/16 below).
+******************************************************************************/
+UBYTE Dither_Row(DITHER *Dither, const UBYTE *Gray)
+{
+    PaintContext *Ctx = Dither->Ctx;
+    if (Dither->Row >= Dither->Height)
+        return 0;
+    if (Ctx->Scale != 2 && Ctx->Scale != 4) {
+        Debug("Dither_Row: only scale 2 and 4\r\n");
+        return 0;
+    }
+
+    UBYTE Steps = Ctx->Scale - 1;
+    UWORD Y = Dither->Ystart + Dither->Row;
+    UBYTE Visible = Y < Ctx->Height;
+    int16_t *Cur = Dither->Error + 1, *Next = Dither->Error + Dither->Width + 3;
+
+    for (UWORD x = 0; x < Dither->Width; x++) {
+        UWORD X = Dither->Xstart + x;
+        UBYTE Level;
+        if (Dither->Mode == DITHER_FLOYD_STEINBERG) {
+            int Value = Gray[x] * 16 + Cur[x];
+            if (Value < 0)
+                Value = 0;
+            if (Value > 255 * 16)
+                Value = 255 * 16;
+            Level = (Value * Steps + 255 * 8) / (255 * 16);
+            int Err = Value - Level * 255 / Steps * 16;
+            int Right = Err * 7 / 16, Left = Err * 3 / 16, Below = Err * 5 / 16;
+            Cur[x + 1] += Right;
+            Next[x - 1] += Left;
+            Next[x] += Below;
+            Next[x + 1] += Err - Right - Left - Below;     //Nothing of the error is lost
+        } else if (Dither->Mode == DITHER_BAYER) {
+            UBYTE Threshold = Dither_Bayer8[Dither->Row % 8][x % 8];
+            Level = ((UDOUBLE)Gray[x] * Steps * 128 + (2 * Threshold + 1) * 255) / (128 * 255);
+            if (Level > Steps)
+                Level = Steps;
+        } else {
+            Level = (Gray[x] * Steps + 127) / 255;
+        }
+        if (Visible && X < Ctx->Width)
+            PaintCtx_SetPixel(Ctx, X, Y, Dither_Color(Ctx->Scale, Level));
+    }
+
+    if (Dither->Mode == DITHER_FLOYD_STEINBERG) {
+        //The next row becomes the current one
+        memcpy(Dither->Error, Next - 1, (Dither->Width + 2) * sizeof(int16_t));
+        memset(Next - 1, 0, (Dither->Width + 2) * sizeof(int16_t));
+    }
+    Dither->Row++;
+    return Dither->Row < Dither->Height;
+}
+
+/******************************************************************************
+function: Dither a whole grayscale image
+parameter:
+    Gray : Width x Height pixels, row by row
+    See Dither_Begin()
+return: 0 if the scratch memory could not be allocated
+******************************************************************************/
+UBYTE Dither_DrawImage(PaintContext *Ctx, const UBYTE *Gray, UWORD Xstart, UWORD Ystart,
+                       UWORD Width, UWORD Height, DITHER_MODE Mode)
+{
+    int16_t *Scratch = NULL;
+    if (Mode == DITHER_FLOYD_STEINBERG) {
+        Scratch = (int16_t *)malloc(DITHER_SCRATCH(Width) * sizeof(int16_t));
+        if (Scratch == NULL)
+            return 0;
+    }
+
+    DITHER Dither;
+    Dither_Begin(&Dither, Ctx, Xstart, Ystart, Width, Height, Mode, Scratch);
+    for (UWORD y = 0; y < Height; y++)
+        Dither_Row(&Dither, Gray + (UDOUBLE)y * Width);
+
+    free(Scratch);
+    return 1;
+}
@@ -0,0 +1,59 @@
+/******************************************************************************
+* | File      	:   GUI_Dither.h
+* | Function    :   Dithering of 8-bit grayscale images into the framebuffer
+* | Info        :
+*   Converts 0 (black) ... 255 (white) gray pixels to the levels of the
+*   canvas: black/white on scale 2, four grays on scale 4 (3 = white, like
+*   WHITE % 4). Rows are fed one at a time, so the source can be decoded,
+*   received or generated row by row. The only state besides the context is
+*   the error of one row for Floyd-Steinberg, see DITHER_SCRATCH().
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-07-07
+* | Info        :
+*   Pixels are written with PaintCtx_SetPixel(), so rotation and mirroring
+*   of the context apply. Source pixels outside the canvas are dropped.
+*
+******************************************************************************/
+#ifndef __GUI_DITHER_H
+#define __GUI_DITHER_H
+
+#include "DEV_Config.h"
+#include "GUI_Paint.h"
+
+/**
+ * Dithering methods
+**/
+typedef enum {
+    DITHER_NONE = 0,            // Nearest level
+    DITHER_BAYER,               // Ordered 8x8 Bayer matrix, no state
+    DITHER_FLOYD_STEINBERG,     // Error diffusion, needs scratch memory
+} DITHER_MODE;
+
+/**
+ * Scratch memory of Floyd-Steinberg in int16_t, two error rows with one
+ * guard pixel on each side
+**/
+#define DITHER_SCRATCH(Width)   (2 * ((Width) + 2))
+
+/**
+ * One image being dithered
+**/
+typedef struct {
+    PaintContext *Ctx;
+    UWORD Xstart;
+    UWORD Ystart;
+    UWORD Width;
+    UWORD Height;
+    UWORD Row;          // Next source row
+    DITHER_MODE Mode;
+    int16_t *Error;     // Floyd-Steinberg only, DITHER_SCRATCH(Width) entries
+} DITHER;
+
+void Dither_Begin(DITHER *Dither, PaintContext *Ctx, UWORD Xstart, UWORD Ystart, UWORD Width, UWORD Height,
+                  DITHER_MODE Mode, int16_t *Scratch);
+UBYTE Dither_Row(DITHER *Dither, const UBYTE *Gray);
+UBYTE Dither_DrawImage(PaintContext *Ctx, const UBYTE *Gray, UWORD Xstart, UWORD Ystart,
+                       UWORD Width, UWORD Height, DITHER_MODE Mode);
+
+#endif
@@ -0,0 +1,145 @@
+/******************************************************************************
+* | File      	:   GUI_Format.cpp
+* | Function    :   Number and time formatting without allocations
+* | Info        :
+*   See GUI_Format.h
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-07-10
+* | Info        :
+*
+******************************************************************************/
+#include "GUI_Format.h"
+
+/******************************************************************************
+function: Write the decimal digits of a number, right aligned
+parameter:
+    End    : One past the last digit
+    Value  : Number to write
+    Digits : Minimum number of digits, padded with '0'
+return: Pointer to the first digit
+******************************************************************************/
+static char *Format_Digits(char *End, UDOUBLE Value, UBYTE Digits)
+{
+    char *p = End;
+    do {
+        *--p = '0' + Value % 10;
+        Value /= 10;
+    } while (Value != 0 || End - p < Digits);
+    return p;
+}
+
+/******************************************************************************
+function: Copy a string built in a scratch buffer to the destination
+******************************************************************************/
+static UBYTE Format_Copy(char *Buffer, UBYTE Size, const char *Start, const char *End)
+{
+    UBYTE Len = End - Start;
+    if (Size == 0)
+        return 0;
+    if (Len >= Size) {
+        Buffer[0] = '\0';
+        return 0;
+    }
+    for (UBYTE i = 0; i < Len; i++)
+        Buffer[i] = Start[i];
+    Buffer[Len] = '\0';
+    return Len;
+}
+
+/******************************************************************************
+function: Unsigned integer
+parameter:
+    Buffer : Destination
+    Size   : Size of the destination including the NUL
+    Value  : Number
+    Digits : Minimum number of digits, padded with '0', at most 10
+return: Length of the string
+******************************************************************************/
+UBYTE Format_UInt(char *Buffer, UBYTE Size, UDOUBLE Value, UBYTE Digits)
+{
+    char Scratch[FORMAT_INT_SIZE];
+    char *End = Scratch + sizeof(Scratch);
+    if (Digits > 10)
+        Digits = 10;
+    return Format_Copy(Buffer, Size, Format_Digits(End, Value, Digits), End);
+}
+
+/******************************************************************************
+function: Signed integer, "-" for negative numbers
+******************************************************************************/
+UBYTE Format_Int(char *Buffer, UBYTE Size, int32_t Value)
+{
+    char Scratch[FORMAT_INT_SIZE];
+    char *End = Scratch + sizeof(Scratch);
+    //The magnitude of INT32_MIN only fits unsigned
+    UDOUBLE Magnitude = (Value < 0) ? 0u - (UDOUBLE)Value : (UDOUBLE)Value;
+    char *p = Format_Digits(End, Magnitude, 1);
+    if (Value < 0)
+        *--p = '-';
+    return Format_Copy(Buffer, Size, p, End);
+}
+
+/******************************************************************************
+function: Fixed-point number
+parameter:
+    Value    : Number in units of 10^-Decimals, e.g. 2150 with 2 -> "21.50"
+    Decimals : Digits after the point, at most 9, 0 formats an integer
+******************************************************************************/
+UBYTE Format_Fixed(char *Buffer, UBYTE Size, int32_t Value, UBYTE Decimals)
+{
+    static const UDOUBLE Powers[10] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+    };
+    char Scratch[FORMAT_FIXED_SIZE];
+    char *End = Scratch + sizeof(Scratch);
+    if (Decimals > 9)
+        Decimals = 9;
+    UDOUBLE Magnitude = (Value < 0) ? 0u - (UDOUBLE)Value : (UDOUBLE)Value;
+    char *p = End;
+    if (Decimals > 0) {
+        p = Format_Digits(End, Magnitude % Powers[Decimals], Decimals);
+        *--p = '.';
+    }
+    p = Format_Digits(p, Magnitude / Powers[Decimals], 1);
+    if (Value < 0)
+        *--p = '-';
+    return Format_Copy(Buffer, Size, p, End);
+}
+
+/******************************************************************************
+function: Time as "hh:mm", both fields zero-padded
+******************************************************************************/
+UBYTE Format_HHMM(char *Buffer, UBYTE Size, UBYTE Hour, UBYTE Min)
+{
+    if (Size < FORMAT_HHMM_SIZE) {
+        if (Size > 0)
+            Buffer[0] = '\0';
+        return 0;
+    }
+    Buffer[0] = '0' + Hour / 10 % 10;
+    Buffer[1] = '0' + Hour % 10;
+    Buffer[2] = ':';
+    Buffer[3] = '0' + Min / 10 % 10;
+    Buffer[4] = '0' + Min % 10;
+    Buffer[5] = '\0';
+    return 5;
+}
+
+/******************************************************************************
+function: Time as "hh:mm:ss", all fields zero-padded
+******************************************************************************/
+UBYTE Format_HHMMSS(char *Buffer, UBYTE Size, UBYTE Hour, UBYTE Min, UBYTE Sec)
+{
+    if (Size < FORMAT_HHMMSS_SIZE) {
+        if (Size > 0)
+            Buffer[0] = '\0';
+        return 0;
+    }
+    Format_HHMM(Buffer, Size, Hour, Min);
+    Buffer[5] = ':';
+    Buffer[6] = '0' + Sec / 10 % 10;
+    Buffer[7] = '0' + Sec % 10;
+    Buffer[8] = '\0';
+    return 8;
+}
@@ -0,0 +1,35 @@
+/******************************************************************************
+* | File      	:   GUI_Format.h
+* | Function    :   Number and time formatting without allocations
+* | Info        :
+*   Every function writes a NUL terminated string into a buffer of the
+*   caller and returns its length. Nothing is allocated and no printf() is
+*   pulled in, so the functions can be used while drawing every frame.
+*   The *_SIZE macros give buffer sizes that always fit.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-07-10
+* | Info        :
+*   If the buffer is too small, an empty string is written and 0 returned.
+*
+******************************************************************************/
+#ifndef __GUI_FORMAT_H
+#define __GUI_FORMAT_H
+
+#include "DEV_Config.h"
+
+/**
+ * Buffer sizes including the terminating NUL
+**/
+#define FORMAT_INT_SIZE     12      // "-2147483648"
+#define FORMAT_FIXED_SIZE   13      // "-21474836.48", one more for the point
+#define FORMAT_HHMM_SIZE    6       // "hh:mm"
+#define FORMAT_HHMMSS_SIZE  9       // "hh:mm:ss"
+
+UBYTE Format_UInt(char *Buffer, UBYTE Size, UDOUBLE Value, UBYTE Digits);
+UBYTE Format_Int(char *Buffer, UBYTE Size, int32_t Value);
+UBYTE Format_Fixed(char *Buffer, UBYTE Size, int32_t Value, UBYTE Decimals);
+UBYTE Format_HHMM(char *Buffer, UBYTE Size, UBYTE Hour, UBYTE Min);
+UBYTE Format_HHMMSS(char *Buffer, UBYTE Size, UBYTE Hour, UBYTE Min, UBYTE Sec);
+
+#endif
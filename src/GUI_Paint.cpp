@@ -76,6 +76,9 @@
 *
 ******************************************************************************/
 #include "GUI_Paint.h"
+#include "GUI_Cache.h"
+#include "GUI_Atlas.h"
+#include "GUI_Format.h"
 #include "DEV_Config.h"
 #include "utility/Debug.h"
 #include <stdint.h>
@@ -93,29 +96,29 @@ parameter:
     Height  :   The height of the picture
     Color   :   Whether the picture is inverted
 ******************************************************************************/
-void Paint_NewImage(UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD Color)
+void PaintCtx_NewImage(PaintContext *Ctx, UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD Color)
 {
-    Paint.Image = NULL;
-    Paint.Image = image;
+    Ctx->Image = NULL;
+    Ctx->Image = image;
 
-    Paint.WidthMemory = Width;
-    Paint.HeightMemory = Height;
-    Paint.Color = Color;    
-    Paint.Scale = 2;
-    Paint.WidthByte = (Width % 8 == 0)? (Width / 8 ): (Width / 8 + 1);
-    Paint.HeightByte = Height;    
+    Ctx->WidthMemory = Width;
+    Ctx->HeightMemory = Height;
+    Ctx->Color = Color;    
+    Ctx->Scale = 2;
+    Ctx->WidthByte = (Width % 8 == 0)? (Width / 8 ): (Width / 8 + 1);
+    Ctx->HeightByte = Height;    
 //    printf("WidthByte = %d, HeightByte = %d\r\n", Paint.WidthByte, Paint.HeightByte);
 //    printf(" EPD_WIDTH / 8 = %d\r\n",  122 / 8);
    
-    Paint.Rotate = Rotate;
-    Paint.Mirror = MIRROR_NONE;
+    Ctx->Rotate = Rotate;
+    Ctx->Mirror = MIRROR_NONE;
     
     if(Rotate == ROTATE_0 || Rotate == ROTATE_180) {
-        Paint.Width = Width;
-        Paint.Height = Height;
+        Ctx->Width = Width;
+        Ctx->Height = Height;
     } else {
-        Paint.Width = Height;
-        Paint.Height = Width;
+        Ctx->Width = Height;
+        Ctx->Height = Width;
     }
 }
 
@@ -124,9 +127,9 @@ function: Select Image
 parameter:
     image : Pointer to the image cache
 ******************************************************************************/
-void Paint_SelectImage(UBYTE *image)
+void PaintCtx_SelectImage(PaintContext *Ctx, UBYTE *image)
 {
-    Paint.Image = image;
+    Ctx->Image = image;
 }
 
 /******************************************************************************
@@ -134,11 +137,11 @@ function: Select Image Rotate
 parameter:
     Rotate : 0,90,180,270
 ******************************************************************************/
-void Paint_SetRotate(UWORD Rotate)
+void PaintCtx_SetRotate(PaintContext *Ctx, UWORD Rotate)
 {
     if(Rotate == ROTATE_0 || Rotate == ROTATE_90 || Rotate == ROTATE_180 || Rotate == ROTATE_270) {
         // Debug("Set image Rotate %d\r\n", Rotate);
-        Paint.Rotate = Rotate;
+        Ctx->Rotate = Rotate;
     } else {
         Debug("rotate = 0, 90, 180, 270\r\n");
     }
@@ -149,197 +152,357 @@ function:	Select Image mirror
 parameter:
     mirror   :Not mirror,Horizontal mirror,Vertical mirror,Origin mirror
 ******************************************************************************/
-void Paint_SetMirroring(UBYTE mirror)
+void PaintCtx_SetMirroring(PaintContext *Ctx, UBYTE mirror)
 {
     if(mirror == MIRROR_NONE || mirror == MIRROR_HORIZONTAL || 
         mirror == MIRROR_VERTICAL || mirror == MIRROR_ORIGIN) {
         // Debug("mirror image x:%s, y:%s\r\n",(mirror & 0x01)? "mirror":"none", ((mirror >> 1) & 0x01)? "mirror":"none");
-        Paint.Mirror = mirror;
+        Ctx->Mirror = mirror;
     } else {
         Debug("mirror should be MIRROR_NONE, MIRROR_HORIZONTAL, \
         MIRROR_VERTICAL or MIRROR_ORIGIN\r\n");
     }    
 }
 
-void Paint_SetScale(UBYTE scale)
+void PaintCtx_SetScale(PaintContext *Ctx, UBYTE scale)
 {
     if(scale == 2){
-        Paint.Scale = scale;
-        Paint.WidthByte = (Paint.WidthMemory % 8 == 0)? (Paint.WidthMemory / 8 ): (Paint.WidthMemory / 8 + 1);
+        Ctx->Scale = scale;
+        Ctx->WidthByte = (Ctx->WidthMemory % 8 == 0)? (Ctx->WidthMemory / 8 ): (Ctx->WidthMemory / 8 + 1);
     }
 	else if(scale == 4) {
-        Paint.Scale = scale;
-        Paint.WidthByte = (Paint.WidthMemory % 4 == 0)? (Paint.WidthMemory / 4 ): (Paint.WidthMemory / 4 + 1);
+        Ctx->Scale = scale;
+        Ctx->WidthByte = (Ctx->WidthMemory % 4 == 0)? (Ctx->WidthMemory / 4 ): (Ctx->WidthMemory / 4 + 1);
     }
 	else if(scale == 7) {//Only applicable with 5in65 e-Paper
-		Paint.Scale = 7;
-		Paint.WidthByte = (Paint.WidthMemory % 2 == 0)? (Paint.WidthMemory / 2 ): (Paint.WidthMemory / 2 + 1);
+		Ctx->Scale = 7;
+		Ctx->WidthByte = (Ctx->WidthMemory % 2 == 0)? (Ctx->WidthMemory / 2 ): (Ctx->WidthMemory / 2 + 1);
 	}
 	else {
         Debug("Set Scale Input parameter error\r\n");
         Debug("Scale Only support: 2 4 7\r\n");
     }
 }
+
 /******************************************************************************
-function: Draw Pixels
+function: Attach a glyph cache to the context
+parameter:
+    Cache : Initialized cache, NULL draws every character pixel by pixel
+******************************************************************************/
+void PaintCtx_SetGlyphCache(PaintContext *Ctx, GLYPH_CACHE *Cache)
+{
+    Ctx->Cache = Cache;
+}
+
+/******************************************************************************
+function: Map a canvas point to the framebuffer
 parameter:
     Xpoint : At point X
     Ypoint : At point Y
-    Color  : Painted colors
+    X      : Framebuffer column (output)
+    Y      : Framebuffer row (output)
+return: 0 if the rotation or mirroring is not supported, else 1
 ******************************************************************************/
-void Paint_SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color)
+static inline UBYTE PaintCtx_Map(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, UWORD *X, UWORD *Y)
 {
-    if(Xpoint > Paint.Width || Ypoint > Paint.Height){
-        Debug("Exceeding display boundaries\r\n");
-        return;
-    }      
-    UWORD X, Y;
-    switch(Paint.Rotate) {
+    switch(Ctx->Rotate) {
     case 0:
-        X = Xpoint;
-        Y = Ypoint;  
+        *X = Xpoint;
+        *Y = Ypoint;  
         break;
     case 90:
-        X = Paint.WidthMemory - Ypoint - 1;
-        Y = Xpoint;
+        *X = Ctx->WidthMemory - Ypoint - 1;
+        *Y = Xpoint;
         break;
     case 180:
-        X = Paint.WidthMemory - Xpoint - 1;
-        Y = Paint.HeightMemory - Ypoint - 1;
+        *X = Ctx->WidthMemory - Xpoint - 1;
+        *Y = Ctx->HeightMemory - Ypoint - 1;
         break;
     case 270:
-        X = Ypoint;
-        Y = Paint.HeightMemory - Xpoint - 1;
+        *X = Ypoint;
+        *Y = Ctx->HeightMemory - Xpoint - 1;
         break;
     default:
-        return;
+        return 0;
     }
     
-    switch(Paint.Mirror) {
+    switch(Ctx->Mirror) {
     case MIRROR_NONE:
         break;
     case MIRROR_HORIZONTAL:
-        X = Paint.WidthMemory - X - 1;
+        *X = Ctx->WidthMemory - *X - 1;
         break;
     case MIRROR_VERTICAL:
-        Y = Paint.HeightMemory - Y - 1;
+        *Y = Ctx->HeightMemory - *Y - 1;
         break;
     case MIRROR_ORIGIN:
-        X = Paint.WidthMemory - X - 1;
-        Y = Paint.HeightMemory - Y - 1;
+        *X = Ctx->WidthMemory - *X - 1;
+        *Y = Ctx->HeightMemory - *Y - 1;
         break;
     default:
-        return;
+        return 0;
     }
+    return 1;
+}
+
+UBYTE PaintCtx_MapPoint(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, UWORD *X, UWORD *Y)
+{
+    return PaintCtx_Map(Ctx, Xpoint, Ypoint, X, Y);
+}
 
-    if(X > Paint.WidthMemory || Y > Paint.HeightMemory){
+/******************************************************************************
+function: Draw Pixels
+parameter:
+    Xpoint : At point X
+    Ypoint : At point Y
+    Color  : Painted colors
+******************************************************************************/
+void PaintCtx_SetPixel(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, UWORD Color)
+{
+    if(Xpoint > Ctx->Width || Ypoint > Ctx->Height){
+        Debug("Exceeding display boundaries\r\n");
+        return;
+    }      
+    UWORD X, Y;
+    if(!PaintCtx_Map(Ctx, Xpoint, Ypoint, &X, &Y))
+        return;
+
+    if(X > Ctx->WidthMemory || Y > Ctx->HeightMemory){
         Debug("Exceeding display boundaries\r\n");
         return;
     }
     
-    if(Paint.Scale == 2){
-        UDOUBLE Addr = X / 8 + Y * Paint.WidthByte;
-        UBYTE Rdata = Paint.Image[Addr];
+    if(Ctx->Scale == 2){
+        UDOUBLE Addr = X / 8 + Y * Ctx->WidthByte;
+        UBYTE Rdata = Ctx->Image[Addr];
         if(Color == BLACK)
-            Paint.Image[Addr] = Rdata & ~(0x80 >> (X % 8));
+            Ctx->Image[Addr] = Rdata & ~(0x80 >> (X % 8));
         else
-            Paint.Image[Addr] = Rdata | (0x80 >> (X % 8));
-    }else if(Paint.Scale == 4){
-        UDOUBLE Addr = X / 4 + Y * Paint.WidthByte;
+            Ctx->Image[Addr] = Rdata | (0x80 >> (X % 8));
+    }else if(Ctx->Scale == 4){
+        UDOUBLE Addr = X / 4 + Y * Ctx->WidthByte;
         Color = Color % 4;//Guaranteed color scale is 4  --- 0~3
-        UBYTE Rdata = Paint.Image[Addr];
+        UBYTE Rdata = Ctx->Image[Addr];
         
         Rdata = Rdata & (~(0xC0 >> ((X % 4)*2)));
-        Paint.Image[Addr] = Rdata | ((Color << 6) >> ((X % 4)*2));
-    }else if(Paint.Scale == 7){
-			UWORD Width = Paint.WidthMemory*3%8 == 0 ? Paint.WidthMemory*3/8 : Paint.WidthMemory*3/8+1;
+        Ctx->Image[Addr] = Rdata | ((Color << 6) >> ((X % 4)*2));
+    }else if(Ctx->Scale == 7){
+			UWORD Width = Ctx->WidthMemory*3%8 == 0 ? Ctx->WidthMemory*3/8 : Ctx->WidthMemory*3/8+1;
 			UDOUBLE Addr = (Xpoint * 3) / 8 + Ypoint * Width;
 			UBYTE shift, Rdata, Rdata2;
-			shift = (Xpoint+Ypoint*Paint.HeightMemory) % 8;
+			shift = (Xpoint+Ypoint*Ctx->HeightMemory) % 8;
 
 			switch(shift) {
 				case 0 :
-					Rdata = Paint.Image[Addr] & 0x1f;
+					Rdata = Ctx->Image[Addr] & 0x1f;
 					Rdata = Rdata | ((Color << 5) & 0xe0);
-					Paint.Image[Addr] = Rdata;
+					Ctx->Image[Addr] = Rdata;
 					break;
 				case 1 :
-					Rdata = Paint.Image[Addr] & 0xe3;
+					Rdata = Ctx->Image[Addr] & 0xe3;
 					Rdata = Rdata | ((Color << 2) & 0x1c);
-					Paint.Image[Addr] = Rdata;
+					Ctx->Image[Addr] = Rdata;
 					break;
 				case 2 :
-					Rdata = Paint.Image[Addr] & 0xfc;
-					Rdata2 = Paint.Image[Addr + 1] & 0x7f;
+					Rdata = Ctx->Image[Addr] & 0xfc;
+					Rdata2 = Ctx->Image[Addr + 1] & 0x7f;
 					Rdata = Rdata | ((Color >> 1) & 0x03);
 					Rdata2 = Rdata2 | ((Color << 7) & 0x80);
-					Paint.Image[Addr] = Rdata;
-					Paint.Image[Addr + 1] = Rdata2;
+					Ctx->Image[Addr] = Rdata;
+					Ctx->Image[Addr + 1] = Rdata2;
 					break;
 				case 3 :
-					Rdata = Paint.Image[Addr] & 0x8f;
+					Rdata = Ctx->Image[Addr] & 0x8f;
 					Rdata = Rdata | ((Color << 4) & 0x70);
-					Paint.Image[Addr] = Rdata;
+					Ctx->Image[Addr] = Rdata;
 					break;
 				case 4 :
-					Rdata = Paint.Image[Addr] & 0xf1;
+					Rdata = Ctx->Image[Addr] & 0xf1;
 					Rdata = Rdata | ((Color << 1) & 0x0e);
-					Paint.Image[Addr] = Rdata;
+					Ctx->Image[Addr] = Rdata;
 					break;
 				case 5 :
-					Rdata = Paint.Image[Addr] & 0xfe;
-					Rdata2 = Paint.Image[Addr + 1] & 0x3f;
+					Rdata = Ctx->Image[Addr] & 0xfe;
+					Rdata2 = Ctx->Image[Addr + 1] & 0x3f;
 					Rdata = Rdata | ((Color >> 2) & 0x01);
 					Rdata2 = Rdata2 | ((Color << 6) & 0xc0);
-					Paint.Image[Addr] = Rdata;
-					Paint.Image[Addr + 1] = Rdata2;
+					Ctx->Image[Addr] = Rdata;
+					Ctx->Image[Addr + 1] = Rdata2;
 					break;
 				case 6 :
-					Rdata = Paint.Image[Addr] & 0xc7;
+					Rdata = Ctx->Image[Addr] & 0xc7;
 					Rdata = Rdata | ((Color << 3) & 0x38);
-					Paint.Image[Addr] = Rdata;
+					Ctx->Image[Addr] = Rdata;
 					break;
 				case 7 :
-					Rdata = Paint.Image[Addr] & 0xf8;
+					Rdata = Ctx->Image[Addr] & 0xf8;
 					Rdata = Rdata | (Color & 0x07);
-					Paint.Image[Addr] = Rdata;
+					Ctx->Image[Addr] = Rdata;
 					break;						
 			}	
 		}
 }
 
+/******************************************************************************
+function: Read a pixel back
+parameter:
+    Xpoint : At point X
+    Ypoint : At point Y
+return: WHITE or BLACK on scale 2, the gray level 0~3 on scale 4, 0 for
+        points outside the canvas and on scale 7
+******************************************************************************/
+UWORD PaintCtx_GetPixel(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint)
+{
+    UWORD X, Y;
+    if(Xpoint >= Ctx->Width || Ypoint >= Ctx->Height || !PaintCtx_Map(Ctx, Xpoint, Ypoint, &X, &Y))
+        return 0;
+
+    if(Ctx->Scale == 2){
+        UBYTE Rdata = Ctx->Image[X / 8 + Y * Ctx->WidthByte];
+        return (Rdata & (0x80 >> (X % 8))) ? WHITE : BLACK;
+    }else if(Ctx->Scale == 4){
+        UBYTE Rdata = Ctx->Image[X / 4 + Y * Ctx->WidthByte];
+        return (Rdata >> (6 - (X % 4)*2)) & 0x03;
+    }
+    return 0;
+}
+
+/******************************************************************************
+function: Fill memory with a repeating 3 byte pattern, one 32-bit word at a time
+parameter:
+    Addr    : Offset of the first byte inside Paint.Image
+    Len     : Number of bytes
+    Pattern : The pattern, Pattern[n] belongs to offsets with offset % 3 == n
+info:
+    Three words cover one period of 12 bytes, so the pattern is rotated only
+    once to the phase of the first aligned word instead of a modulo per byte.
+******************************************************************************/
+static void PaintCtx_FillPattern3(PaintContext *Ctx, UDOUBLE Addr, UDOUBLE Len, const UBYTE Pattern[3])
+{
+    UBYTE *p = Ctx->Image + Addr;
+    UBYTE *end = p + Len;
+
+    //Head bytes up to the first aligned word
+    while (p < end && ((uintptr_t)p & 3)) {
+        *p++ = Pattern[Addr++ % 3];
+    }
+
+    UBYTE Period[12];
+    for (UBYTE i = 0; i < 12; i++)
+        Period[i] = Pattern[(Addr + i) % 3];
+    UDOUBLE Word[3];
+    memcpy(Word, Period, sizeof(Word));
+
+    UDOUBLE *w = (UDOUBLE *)p;
+    UDOUBLE Words = (UDOUBLE)(end - p) / 4;
+    for (; Words >= 3; Words -= 3) {
+        w[0] = Word[0];
+        w[1] = Word[1];
+        w[2] = Word[2];
+        w += 3;
+    }
+    for (UBYTE i = 0; i < Words; i++)
+        *w++ = Word[i];
+
+    //Tail bytes
+    p = (UBYTE *)w;
+    for (UBYTE i = Words * 4; p < end; i++)
+        *p++ = Period[i];
+}
+
 /******************************************************************************
 function: Clear the color of the picture
 parameter:
     Color : Painted colors
 ******************************************************************************/
-void Paint_Clear(UWORD Color)
+void PaintCtx_Clear(PaintContext *Ctx, UWORD Color)
 {
-    if(Paint.Scale == 2 || Paint.Scale == 4) {
-		for (UWORD Y = 0; Y < Paint.HeightByte; Y++) {
-			for (UWORD X = 0; X < Paint.WidthByte; X++ ) {//8 pixel =  1 byte
-				UDOUBLE Addr = X + Y*Paint.WidthByte;
-				Paint.Image[Addr] = Color;
-			}
-		}
+    if(Ctx->Scale == 2 || Ctx->Scale == 4) {
+        //Every byte gets the same value, memset() writes whole words
+        memset(Ctx->Image, (UBYTE)Color, (UDOUBLE)Ctx->WidthByte * Ctx->HeightByte);
 	}
-	if(Paint.Scale == 7) {
+	if(Ctx->Scale == 7) {
 		Color = (UBYTE)Color;
-		UWORD Width = (Paint.WidthMemory * 3 % 8 == 0)? (Paint.WidthMemory * 3 / 8 ): (Paint.WidthMemory * 3 / 8 + 1);
-		for (UWORD Y = 0; Y < Paint.HeightByte; Y++) {
-			for (UWORD X = 0; X < Width; X++ ) {
-				UDOUBLE Addr = X + Y * Width;
-				if((X + Y * Width)%3 == 0) 
-					Paint.Image[Addr] = ((Color<<5) | (Color<<2) | (Color>>1));							
-				else if((X + Y * Width)%3 == 1) 
-					Paint.Image[Addr] = ((Color<<7) | (Color<<4) | (Color<<1) | (Color>>2));				
-				else if((X + Y * Width)%3 == 2)
-					Paint.Image[Addr] = ((Color<<6) | (Color<<3) |  Color);				
-			}
-		}
+		UWORD Width = (Ctx->WidthMemory * 3 % 8 == 0)? (Ctx->WidthMemory * 3 / 8 ): (Ctx->WidthMemory * 3 / 8 + 1);
+		UBYTE Pattern[3] = {
+			(UBYTE)((Color<<5) | (Color<<2) | (Color>>1)),
+			(UBYTE)((Color<<7) | (Color<<4) | (Color<<1) | (Color>>2)),
+			(UBYTE)((Color<<6) | (Color<<3) |  Color),
+		};
+		PaintCtx_FillPattern3(Ctx, 0, (UDOUBLE)Width * Ctx->HeightByte, Pattern);
 	}
 }
 
+/******************************************************************************
+function: Fill a rectangle of the canvas directly in the framebuffer
+parameter:
+    Xstart : x starting point
+    Ystart : Y starting point
+    Xend   : x end point (inclusive)
+    Yend   : y end point (inclusive)
+    Color  : Painted colors
+return: 0 if the canvas can not be filled this way, the caller then has to
+        fall back to Paint_SetPixel()
+info:
+    The rectangle must lie on the canvas. It is mapped to the framebuffer once
+    and filled line by line with masked edge bytes and memset() in between.
+******************************************************************************/
+static UBYTE PaintCtx_FillSpan(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
+{
+    if (Ctx->Scale != 2 && Ctx->Scale != 4)
+        return 0;
+
+    UWORD Xa, Ya, Xb, Yb;
+    if (!PaintCtx_Map(Ctx, Xstart, Ystart, &Xa, &Ya) || !PaintCtx_Map(Ctx, Xend, Yend, &Xb, &Yb))
+        return 0;
+    UWORD X0 = Xa < Xb ? Xa : Xb, X1 = Xa < Xb ? Xb : Xa;
+    UWORD Y0 = Ya < Yb ? Ya : Yb, Y1 = Ya < Yb ? Yb : Ya;
+
+    UBYTE Bits = (Ctx->Scale == 2) ? 1 : 2;
+    UBYTE Fill = (Ctx->Scale == 2) ? ((Color == BLACK) ? 0x00 : 0xFF) : (UBYTE)((Color % 4) * 0x55);
+    UDOUBLE First = (UDOUBLE)X0 * Bits, Last = (UDOUBLE)(X1 + 1) * Bits - 1;
+    UDOUBLE B0 = First / 8, B1 = Last / 8;
+    UBYTE M0 = 0xFF >> (First % 8);
+    UBYTE M1 = (UBYTE)(0xFF << (7 - Last % 8));
+    if (B0 == B1)
+        M0 &= M1;
+
+    for (UDOUBLE Y = Y0; Y <= Y1; Y++) {
+        UBYTE *Row = Ctx->Image + Y * Ctx->WidthByte;
+        Row[B0] = (Row[B0] & ~M0) | (Fill & M0);
+        if (B1 > B0) {
+            memset(Row + B0 + 1, Fill, B1 - B0 - 1);
+            Row[B1] = (Row[B1] & ~M1) | (Fill & M1);
+        }
+    }
+    return 1;
+}
+
+/******************************************************************************
+function: Check that a rectangle lies on the canvas
+******************************************************************************/
+static UBYTE PaintCtx_OnCanvas(PaintContext *Ctx, int32_t Xstart, int32_t Ystart, int32_t Xend, int32_t Yend)
+{
+    return Xstart >= 0 && Ystart >= 0 && Xstart <= Xend && Ystart <= Yend &&
+           Xend < Ctx->Width && Yend < Ctx->Height;
+}
+
+/******************************************************************************
+function: Set one framebuffer pixel, without mapping or range checks
+******************************************************************************/
+static inline void PaintCtx_PutPixel(PaintContext *Ctx, UWORD X, UWORD Y, UWORD Color)
+{
+    UBYTE *Row = Ctx->Image + (UDOUBLE)Y * Ctx->WidthByte;
+    if (Ctx->Scale == 2) {
+        if (Color == BLACK)
+            Row[X / 8] &= ~(0x80 >> (X % 8));
+        else
+            Row[X / 8] |= 0x80 >> (X % 8);
+    } else {
+        Row[X / 4] = (Row[X / 4] & ~(0xC0 >> ((X % 4) * 2))) | (((Color % 4) << 6) >> ((X % 4) * 2));
+    }
+}
+
 /******************************************************************************
 function: Clear the color of a window
 parameter:
@@ -349,12 +512,16 @@ parameter:
     Yend   : y end point
     Color  : Painted colors
 ******************************************************************************/
-void Paint_ClearWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
+void PaintCtx_ClearWindows(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
 {
+    if (PaintCtx_OnCanvas(Ctx, Xstart, Ystart, Xend - 1, Yend - 1) &&
+        PaintCtx_FillSpan(Ctx, Xstart, Ystart, Xend - 1, Yend - 1, Color))
+        return;
+
     UWORD X, Y;
     for (Y = Ystart; Y < Yend; Y++) {
         for (X = Xstart; X < Xend; X++) {//8 pixel =  1 byte
-            Paint_SetPixel(X, Y, Color);
+            PaintCtx_SetPixel(Ctx, X, Y, Color);
         }
     }
 }
@@ -368,14 +535,23 @@ parameter:
     Dot_Pixel	: point size
     Dot_Style	: point Style
 ******************************************************************************/
-void Paint_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color,
+void PaintCtx_DrawPoint(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, UWORD Color,
                      DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_Style)
 {
-    if (Xpoint > Paint.Width || Ypoint > Paint.Height) {
+    if (Xpoint > Ctx->Width || Ypoint > Ctx->Height) {
         Debug("Paint_DrawPoint Input exceeds the normal display range\r\n");
         return;
     }
 
+    //The whole dot on the canvas: one span fill
+    if (Dot_Pixel > DOT_PIXEL_1X1) {
+        int32_t First = (Dot_Style == DOT_FILL_AROUND) ? -(int32_t)Dot_Pixel : -1;
+        int32_t Last = Dot_Pixel - 2;
+        if (PaintCtx_OnCanvas(Ctx, Xpoint + First, Ypoint + First, Xpoint + Last, Ypoint + Last) &&
+            PaintCtx_FillSpan(Ctx, Xpoint + First, Ypoint + First, Xpoint + Last, Ypoint + Last, Color))
+            return;
+    }
+
     int16_t XDir_Num , YDir_Num;
     if (Dot_Style == DOT_FILL_AROUND) {
         for (XDir_Num = 0; XDir_Num < 2 * Dot_Pixel - 1; XDir_Num++) {
@@ -383,18 +559,74 @@ void Paint_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color,
                 if(Xpoint + XDir_Num - Dot_Pixel < 0 || Ypoint + YDir_Num - Dot_Pixel < 0)
                     break;
                 // printf("x = %d, y = %d\r\n", Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel);
-                Paint_SetPixel(Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel, Color);
+                PaintCtx_SetPixel(Ctx, Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel, Color);
             }
         }
     } else {
         for (XDir_Num = 0; XDir_Num <  Dot_Pixel; XDir_Num++) {
             for (YDir_Num = 0; YDir_Num <  Dot_Pixel; YDir_Num++) {
-                Paint_SetPixel(Xpoint + XDir_Num - 1, Ypoint + YDir_Num - 1, Color);
+                PaintCtx_SetPixel(Ctx, Xpoint + XDir_Num - 1, Ypoint + YDir_Num - 1, Color);
             }
         }
     }
 }
 
+/******************************************************************************
+function: Draw a 1 pixel line by stepping through the framebuffer
+parameter:
+    See Paint_DrawLine()
+return: 0 if the canvas is not supported
+info:
+    Same Bresenham walk and the same pixels as Paint_DrawLine(), but a step
+    on the canvas is translated once into a framebuffer step instead of
+    mapping every point through Paint_DrawPoint() and Paint_SetPixel().
+    The line must lie on the canvas.
+******************************************************************************/
+static UBYTE PaintCtx_StepLine(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
+{
+    if (Ctx->Scale != 2 && Ctx->Scale != 4)
+        return 0;
+
+    //A dot of DOT_PIXEL_1X1 is drawn at (x - 1, y - 1)
+    UWORD X0, Y0, X1, Y1, X2, Y2;
+    if (!PaintCtx_Map(Ctx, Xstart - 1, Ystart - 1, &X0, &Y0) ||
+        !PaintCtx_Map(Ctx, Xstart, Ystart - 1, &X1, &Y1) ||
+        !PaintCtx_Map(Ctx, Xstart - 1, Ystart, &X2, &Y2))
+        return 0;
+    int Step_XX = (int16_t)(X1 - X0), Step_XY = (int16_t)(Y1 - Y0);
+    int Step_YX = (int16_t)(X2 - X0), Step_YY = (int16_t)(Y2 - Y0);
+
+    UWORD Xpoint = Xstart;
+    UWORD Ypoint = Ystart;
+    int dx = (int)Xend - (int)Xstart >= 0 ? Xend - Xstart : Xstart - Xend;
+    int dy = (int)Yend - (int)Ystart <= 0 ? Yend - Ystart : Ystart - Yend;
+    int XAddway = Xstart < Xend ? 1 : -1;
+    int YAddway = Ystart < Yend ? 1 : -1;
+    int Esp = dx + dy;
+    int X = X0, Y = Y0;
+
+    for (;;) {
+        PaintCtx_PutPixel(Ctx, X, Y, Color);
+        if (2 * Esp >= dy) {
+            if (Xpoint == Xend)
+                break;
+            Esp += dy;
+            Xpoint += XAddway;
+            X += XAddway * Step_XX;
+            Y += XAddway * Step_XY;
+        }
+        if (2 * Esp <= dx) {
+            if (Ypoint == Yend)
+                break;
+            Esp += dx;
+            Ypoint += YAddway;
+            X += YAddway * Step_YX;
+            Y += YAddway * Step_YY;
+        }
+    }
+    return 1;
+}
+
 /******************************************************************************
 function: Draw a line of arbitrary slope
 parameter:
@@ -406,15 +638,28 @@ parameter:
     Line_width : Line width
     Line_Style: Solid and dotted lines
 ******************************************************************************/
-void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+void PaintCtx_DrawLine(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
                     UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style)
 {
-    if (Xstart > Paint.Width || Ystart > Paint.Height ||
-        Xend > Paint.Width || Yend > Paint.Height) {
+    if (Xstart > Ctx->Width || Ystart > Ctx->Height ||
+        Xend > Ctx->Width || Yend > Ctx->Height) {
         Debug("Paint_DrawLine Input exceeds the normal display range\r\n");
         return;
     }
 
+    //Solid lines lying completely on the canvas are drawn straight into the framebuffer
+    if (Line_Style == LINE_STYLE_SOLID && Line_width >= 1 &&
+        PaintCtx_OnCanvas(Ctx, (Xstart < Xend ? Xstart : Xend) - Line_width, (Ystart < Yend ? Ystart : Yend) - Line_width,
+                       (Xstart < Xend ? Xend : Xstart) + Line_width - 2, (Ystart < Yend ? Yend : Ystart) + Line_width - 2)) {
+        //Horizontal and vertical lines: the dots add up to one rectangle
+        if ((Xstart == Xend || Ystart == Yend) &&
+            PaintCtx_FillSpan(Ctx, (Xstart < Xend ? Xstart : Xend) - Line_width, (Ystart < Yend ? Ystart : Yend) - Line_width,
+                           (Xstart < Xend ? Xend : Xstart) + Line_width - 2, (Ystart < Yend ? Yend : Ystart) + Line_width - 2, Color))
+            return;
+        if (Line_width == DOT_PIXEL_1X1 && PaintCtx_StepLine(Ctx, Xstart, Ystart, Xend, Yend, Color))
+            return;
+    }
+
     UWORD Xpoint = Xstart;
     UWORD Ypoint = Ystart;
     int dx = (int)Xend - (int)Xstart >= 0 ? Xend - Xstart : Xstart - Xend;
@@ -433,10 +678,10 @@ void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
         //Painted dotted line, 2 point is really virtual
         if (Line_Style == LINE_STYLE_DOTTED && Dotted_Len % 3 == 0) {
             //Debug("LINE_DOTTED\r\n");
-            Paint_DrawPoint(Xpoint, Ypoint, IMAGE_BACKGROUND, Line_width, DOT_STYLE_DFT);
+            PaintCtx_DrawPoint(Ctx, Xpoint, Ypoint, IMAGE_BACKGROUND, Line_width, DOT_STYLE_DFT);
             Dotted_Len = 0;
         } else {
-            Paint_DrawPoint(Xpoint, Ypoint, Color, Line_width, DOT_STYLE_DFT);
+            PaintCtx_DrawPoint(Ctx, Xpoint, Ypoint, Color, Line_width, DOT_STYLE_DFT);
         }
         if (2 * Esp >= dy) {
             if (Xpoint == Xend)
@@ -464,11 +709,11 @@ parameter:
     Line_width: Line width
     Draw_Fill : Whether to fill the inside of the rectangle
 ******************************************************************************/
-void Paint_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+void PaintCtx_DrawRectangle(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
                          UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
 {
-    if (Xstart > Paint.Width || Ystart > Paint.Height ||
-        Xend > Paint.Width || Yend > Paint.Height) {
+    if (Xstart > Ctx->Width || Ystart > Ctx->Height ||
+        Xend > Ctx->Width || Yend > Ctx->Height) {
         Debug("Input exceeds the normal display range\r\n");
         return;
     }
@@ -476,13 +721,34 @@ void Paint_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
     if (Draw_Fill) {
         UWORD Ypoint;
         for(Ypoint = Ystart; Ypoint < Yend; Ypoint++) {
-            Paint_DrawLine(Xstart, Ypoint, Xend, Ypoint, Color , Line_width, LINE_STYLE_SOLID);
+            PaintCtx_DrawLine(Ctx, Xstart, Ypoint, Xend, Ypoint, Color , Line_width, LINE_STYLE_SOLID);
         }
     } else {
-        Paint_DrawLine(Xstart, Ystart, Xend, Ystart, Color, Line_width, LINE_STYLE_SOLID);
-        Paint_DrawLine(Xstart, Ystart, Xstart, Yend, Color, Line_width, LINE_STYLE_SOLID);
-        Paint_DrawLine(Xend, Yend, Xend, Ystart, Color, Line_width, LINE_STYLE_SOLID);
-        Paint_DrawLine(Xend, Yend, Xstart, Yend, Color, Line_width, LINE_STYLE_SOLID);
+        PaintCtx_DrawLine(Ctx, Xstart, Ystart, Xend, Ystart, Color, Line_width, LINE_STYLE_SOLID);
+        PaintCtx_DrawLine(Ctx, Xstart, Ystart, Xstart, Yend, Color, Line_width, LINE_STYLE_SOLID);
+        PaintCtx_DrawLine(Ctx, Xend, Yend, Xend, Ystart, Color, Line_width, LINE_STYLE_SOLID);
+        PaintCtx_DrawLine(Ctx, Xend, Yend, Xstart, Yend, Color, Line_width, LINE_STYLE_SOLID);
+    }
+}
+
+/******************************************************************************
+function: Two symmetric spans of a filled circle
+parameter:
+    Xc, Yc : Center
+    Offset : Distance of both spans from the center
+    Half   : Half length of the spans
+info:
+    The filled 8-point circle is symmetric in x and y, so the spans are laid
+    along the canvas axis that runs along the framebuffer lines.
+******************************************************************************/
+static void PaintCtx_CircleSpans(PaintContext *Ctx, int32_t Xc, int32_t Yc, int32_t Offset, int32_t Half, UWORD Color)
+{
+    if (Ctx->Rotate == ROTATE_0 || Ctx->Rotate == ROTATE_180) {
+        PaintCtx_FillSpan(Ctx, Xc - Half, Yc + Offset, Xc + Half, Yc + Offset, Color);
+        PaintCtx_FillSpan(Ctx, Xc - Half, Yc - Offset, Xc + Half, Yc - Offset, Color);
+    } else {
+        PaintCtx_FillSpan(Ctx, Xc + Offset, Yc - Half, Xc + Offset, Yc + Half, Color);
+        PaintCtx_FillSpan(Ctx, Xc - Offset, Yc - Half, Xc - Offset, Yc + Half, Color);
     }
 }
 
@@ -497,10 +763,10 @@ parameter:
     Line_width: Line width
     Draw_Fill : Whether to fill the inside of the Circle
 ******************************************************************************/
-void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
+void PaintCtx_DrawCircle(PaintContext *Ctx, UWORD X_Center, UWORD Y_Center, UWORD Radius,
                       UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
 {
-    if (X_Center > Paint.Width || Y_Center >= Paint.Height) {
+    if (X_Center > Ctx->Width || Y_Center >= Ctx->Height) {
         Debug("Paint_DrawCircle Input exceeds the normal display range\r\n");
         return;
     }
@@ -513,18 +779,38 @@ void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
     //Cumulative error,judge the next point of the logo
     int16_t Esp = 3 - (Radius << 1 );
 
+    //Filled circle completely on the canvas: scanline spans
+    if (Draw_Fill == DRAW_FILL_FULL && (Ctx->Scale == 2 || Ctx->Scale == 4) &&
+        PaintCtx_OnCanvas(Ctx, X_Center - Radius - 1, Y_Center - Radius - 1, X_Center + Radius - 1, Y_Center + Radius - 1)) {
+        while (XCurrent <= YCurrent) {
+            PaintCtx_CircleSpans(Ctx, X_Center - 1, Y_Center - 1, XCurrent, YCurrent, Color);
+            int16_t YLast = YCurrent;
+            if (Esp < 0 )
+                Esp += 4 * XCurrent + 6;
+            else {
+                Esp += 10 + 4 * (XCurrent - YCurrent );
+                YCurrent --;
+            }
+            XCurrent ++;
+            //The widest span of the line YLast is known once Y moves on
+            if (YCurrent != YLast || XCurrent > YCurrent)
+                PaintCtx_CircleSpans(Ctx, X_Center - 1, Y_Center - 1, YLast, XCurrent - 1, Color);
+        }
+        return;
+    }
+
     int16_t sCountY;
     if (Draw_Fill == DRAW_FILL_FULL) {
         while (XCurrent <= YCurrent ) { //Realistic circles
             for (sCountY = XCurrent; sCountY <= YCurrent; sCountY ++ ) {
-                Paint_DrawPoint(X_Center + XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//1
-                Paint_DrawPoint(X_Center - XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//2
-                Paint_DrawPoint(X_Center - sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//3
-                Paint_DrawPoint(X_Center - sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//4
-                Paint_DrawPoint(X_Center - XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//5
-                Paint_DrawPoint(X_Center + XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//6
-                Paint_DrawPoint(X_Center + sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//7
-                Paint_DrawPoint(X_Center + sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+                PaintCtx_DrawPoint(Ctx, X_Center + XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//1
+                PaintCtx_DrawPoint(Ctx, X_Center - XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//2
+                PaintCtx_DrawPoint(Ctx, X_Center - sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//3
+                PaintCtx_DrawPoint(Ctx, X_Center - sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//4
+                PaintCtx_DrawPoint(Ctx, X_Center - XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//5
+                PaintCtx_DrawPoint(Ctx, X_Center + XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//6
+                PaintCtx_DrawPoint(Ctx, X_Center + sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);//7
+                PaintCtx_DrawPoint(Ctx, X_Center + sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
             }
             if (Esp < 0 )
                 Esp += 4 * XCurrent + 6;
@@ -536,14 +822,14 @@ void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
         }
     } else { //Draw a hollow circle
         while (XCurrent <= YCurrent ) {
-            Paint_DrawPoint(X_Center + XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);//1
-            Paint_DrawPoint(X_Center - XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);//2
-            Paint_DrawPoint(X_Center - YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);//3
-            Paint_DrawPoint(X_Center - YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);//4
-            Paint_DrawPoint(X_Center - XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);//5
-            Paint_DrawPoint(X_Center + XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);//6
-            Paint_DrawPoint(X_Center + YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);//7
-            Paint_DrawPoint(X_Center + YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);//0
+            PaintCtx_DrawPoint(Ctx, X_Center + XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);//1
+            PaintCtx_DrawPoint(Ctx, X_Center - XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);//2
+            PaintCtx_DrawPoint(Ctx, X_Center - YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);//3
+            PaintCtx_DrawPoint(Ctx, X_Center - YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);//4
+            PaintCtx_DrawPoint(Ctx, X_Center - XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);//5
+            PaintCtx_DrawPoint(Ctx, X_Center + XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);//6
+            PaintCtx_DrawPoint(Ctx, X_Center + YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);//7
+            PaintCtx_DrawPoint(Ctx, X_Center + YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);//0
 
             if (Esp < 0 )
                 Esp += 4 * XCurrent + 6;
@@ -556,6 +842,83 @@ void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius,
     }
 }
 
+/******************************************************************************
+function: Fill a polygon with scanline spans
+parameter:
+    Xpoints : x coordinates of the corners
+    Ypoints : y coordinates of the corners
+    Points  : Number of corners, 3 ... PAINT_POLYGON_POINTS
+    Color   : Fill color
+info:
+    The corners are pixel corners: (0,0) (4,0) (4,2) (0,2) covers 4x2 pixels.
+    A pixel is filled when its center lies inside or on the outline
+    (even-odd rule). Pixel centers never meet a corner, so the result does
+    not depend on the direction of the spans: these are laid along the
+    canvas axis that runs along the framebuffer lines, like the spans of a
+    filled circle. Parts outside the canvas are clipped.
+******************************************************************************/
+void PaintCtx_FillPolygon(PaintContext *Ctx, const int16_t *Xpoints, const int16_t *Ypoints, UBYTE Points, UWORD Color)
+{
+    if (Points < 3 || Points > PAINT_POLYGON_POINTS) {
+        Debug("Paint_FillPolygon: unsupported number of points\r\n");
+        return;
+    }
+
+    //U runs along a span, V from span to span
+    UBYTE Columns = !(Ctx->Rotate == ROTATE_0 || Ctx->Rotate == ROTATE_180);
+    const int16_t *U = Columns ? Ypoints : Xpoints;
+    const int16_t *V = Columns ? Xpoints : Ypoints;
+    int32_t ULimit = Columns ? Ctx->Height : Ctx->Width;
+    int32_t VLimit = Columns ? Ctx->Width : Ctx->Height;
+
+    int32_t VMin = V[0], VMax = V[0];
+    for (UBYTE i = 1; i < Points; i++) {
+        if (V[i] < VMin) VMin = V[i];
+        if (V[i] > VMax) VMax = V[i];
+    }
+    if (VMin < 0) VMin = 0;
+    if (VMax > VLimit) VMax = VLimit;
+
+    int32_t Cross[PAINT_POLYGON_POINTS];
+    for (int32_t Line = VMin; Line < VMax; Line++) {
+        //Crossings of the edges with the pixel centers of the line, in 1/256 pixel
+        int32_t Center = 2 * Line + 1;
+        UBYTE n = 0;
+        for (UBYTE i = 0; i < Points; i++) {
+            UBYTE j = (i + 1 < Points) ? i + 1 : 0;
+            int32_t Va = 2 * V[i], Vb = 2 * V[j];
+            if ((Va <= Center && Center < Vb) || (Vb <= Center && Center < Va)) {
+                int32_t C = U[i] * 256 + (U[j] - U[i]) * (Center - Va) * 256 / (Vb - Va);
+                if (C < 0) C = 0;
+                if (C > ULimit * 256) C = ULimit * 256;
+                //Insertion sort, there are only a few crossings per line
+                UBYTE k = n++;
+                for (; k > 0 && Cross[k - 1] > C; k--)
+                    Cross[k] = Cross[k - 1];
+                Cross[k] = C;
+            }
+        }
+
+        for (UBYTE k = 0; k + 1 < n; k += 2) {
+            //First and last pixel whose center lies between the crossings
+            int32_t Start = (Cross[k] + 127) / 256;
+            int32_t End = (Cross[k + 1] + 128) / 256 - 1;
+            if (End < Start)
+                continue;
+            UBYTE Done = Columns ? PaintCtx_FillSpan(Ctx, Line, Start, Line, End, Color)
+                                 : PaintCtx_FillSpan(Ctx, Start, Line, End, Line, Color);
+            if (Done)
+                continue;
+            for (int32_t P = Start; P <= End; P++) {
+                if (Columns)
+                    PaintCtx_SetPixel(Ctx, Line, P, Color);
+                else
+                    PaintCtx_SetPixel(Ctx, P, Line, Color);
+            }
+        }
+    }
+}
+
 /******************************************************************************
 function: Show English characters
 parameter:
@@ -566,17 +929,25 @@ parameter:
     Color_Foreground : Select the foreground color
     Color_Background : Select the background color
 ******************************************************************************/
-void Paint_DrawChar(UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
+void PaintCtx_DrawChar(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
                     sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
 {
     UWORD Page, Column;
 
-    if (Xpoint > Paint.Width || Ypoint > Paint.Height) {
+    if (Xpoint > Ctx->Width || Ypoint > Ctx->Height) {
         Debug("Paint_DrawChar Input exceeds the normal display range\r\n");
         return;
     }
 
-    uint32_t Char_Offset = (Acsii_Char - ' ') * Font->Height * (Font->Width / 8 + (Font->Width % 8 ? 1 : 0));
+    //Characters missing from the font's table are skipped
+    int Glyph = Font_GlyphIndex(Font, Acsii_Char);
+    if (Glyph < 0)
+        return;
+
+    if (GlyphCache_DrawChar(Ctx, Xpoint, Ypoint, Acsii_Char, Font, Color_Foreground, Color_Background))
+        return;
+
+    uint32_t Char_Offset = Glyph * Font->Height * (Font->Width / 8 + (Font->Width % 8 ? 1 : 0));
     const unsigned char *ptr = &Font->table[Char_Offset];
 
     for (Page = 0; Page < Font->Height; Page ++ ) {
@@ -585,14 +956,14 @@ void Paint_DrawChar(UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
             //To determine whether the font background color and screen background color is consistent
             if (FONT_BACKGROUND == Color_Background) { //this process is to speed up the scan
                 if (*ptr & (0x80 >> (Column % 8)))
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Foreground);
+                    PaintCtx_SetPixel(Ctx, Xpoint + Column, Ypoint + Page, Color_Foreground);
                     // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
             } else {
                 if (*ptr & (0x80 >> (Column % 8))) {
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Foreground);
+                    PaintCtx_SetPixel(Ctx, Xpoint + Column, Ypoint + Page, Color_Foreground);
                     // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
                 } else {
-                    Paint_SetPixel(Xpoint + Column, Ypoint + Page, Color_Background);
+                    PaintCtx_SetPixel(Ctx, Xpoint + Column, Ypoint + Page, Color_Background);
                     // Paint_DrawPoint(Xpoint + Column, Ypoint + Page, Color_Background, DOT_PIXEL_DFT, DOT_STYLE_DFT);
                 }
             }
@@ -615,30 +986,30 @@ parameter:
     Color_Foreground : Select the foreground color
     Color_Background : Select the background color
 ******************************************************************************/
-void Paint_DrawString_EN(UWORD Xstart, UWORD Ystart, const char * pString,
+void PaintCtx_DrawString_EN(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, const char * pString,
                          sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
 {
     UWORD Xpoint = Xstart;
     UWORD Ypoint = Ystart;
 
-    if (Xstart > Paint.Width || Ystart > Paint.Height) {
+    if (Xstart > Ctx->Width || Ystart > Ctx->Height) {
         Debug("Paint_DrawString_EN Input exceeds the normal display range\r\n");
         return;
     }
 
     while (* pString != '\0') {
         //if X direction filled , reposition to(Xstart,Ypoint),Ypoint is Y direction plus the Height of the character
-        if ((Xpoint + Font->Width ) > Paint.Width ) {
+        if ((Xpoint + Font->Width ) > Ctx->Width ) {
             Xpoint = Xstart;
             Ypoint += Font->Height;
         }
 
         // If the Y direction is full, reposition to(Xstart, Ystart)
-        if ((Ypoint  + Font->Height ) > Paint.Height ) {
+        if ((Ypoint  + Font->Height ) > Ctx->Height ) {
             Xpoint = Xstart;
             Ypoint = Ystart;
         }
-        Paint_DrawChar(Xpoint, Ypoint, * pString, Font, Color_Background, Color_Foreground);
+        PaintCtx_DrawChar(Ctx, Xpoint, Ypoint, * pString, Font, Color_Background, Color_Foreground);
 
         //The next character of the address
         pString ++;
@@ -649,6 +1020,55 @@ void Paint_DrawString_EN(UWORD Xstart, UWORD Ystart, const char * pString,
 }
 
 
+/******************************************************************************
+function:	Display an anti-aliased character
+parameter:
+    See PaintCtx_DrawChar(), Font is a glyph atlas
+info:
+    Characters the atlas can't blit (other canvas, colors or characters) are
+    drawn from the 1-bpp font of the atlas.
+******************************************************************************/
+void PaintCtx_DrawChar_Gray(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, const char Acsii_Char,
+                            const sFONT_GRAY* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    if (GrayAtlas_DrawChar(Ctx, Xpoint, Ypoint, Acsii_Char, Font, Color_Foreground, Color_Background))
+        return;
+    PaintCtx_DrawChar(Ctx, Xpoint, Ypoint, Acsii_Char, (sFONT*)Font->Mono, Color_Foreground, Color_Background);
+}
+
+/******************************************************************************
+function:	Display an anti-aliased string
+parameter:
+    See PaintCtx_DrawString_EN(), Font is a glyph atlas
+******************************************************************************/
+void PaintCtx_DrawString_Gray(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, const char * pString,
+                              const sFONT_GRAY* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    UWORD Xpoint = Xstart;
+    UWORD Ypoint = Ystart;
+    const sFONT *Mono = Font->Mono;
+
+    if (Xstart > Ctx->Width || Ystart > Ctx->Height) {
+        Debug("Paint_DrawString_Gray Input exceeds the normal display range\r\n");
+        return;
+    }
+
+    while (* pString != '\0') {
+        //Same line breaks as PaintCtx_DrawString_EN()
+        if ((Xpoint + Mono->Width ) > Ctx->Width ) {
+            Xpoint = Xstart;
+            Ypoint += Mono->Height;
+        }
+        if ((Ypoint  + Mono->Height ) > Ctx->Height ) {
+            Xpoint = Xstart;
+            Ypoint = Ystart;
+        }
+        PaintCtx_DrawChar_Gray(Ctx, Xpoint, Ypoint, * pString, Font, Color_Background, Color_Foreground);
+        pString ++;
+        Xpoint += Mono->Width;
+    }
+}
+
 /******************************************************************************
 function: Display the string
 parameter:
@@ -660,7 +1080,7 @@ parameter:
     Color_Foreground : Select the foreground color
     Color_Background : Select the background color
 ******************************************************************************/
-void Paint_DrawString_CN(UWORD Xstart, UWORD Ystart, const char * pString, cFONT* font,
+void PaintCtx_DrawString_CN(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, const char * pString, cFONT* font,
                         UWORD Color_Foreground, UWORD Color_Background)
 {
     const char* p_text = pString;
@@ -678,15 +1098,15 @@ void Paint_DrawString_CN(UWORD Xstart, UWORD Ystart, const char * pString, cFONT
                         for (i = 0; i < font->Width; i++) {
                             if (FONT_BACKGROUND == Color_Background) { //this process is to speed up the scan
                                 if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
+                                    PaintCtx_SetPixel(Ctx, x + i, y + j, Color_Foreground);
                                     // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
                                 }
                             } else {
                                 if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
+                                    PaintCtx_SetPixel(Ctx, x + i, y + j, Color_Foreground);
                                     // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
                                 } else {
-                                    Paint_SetPixel(x + i, y + j, Color_Background);
+                                    PaintCtx_SetPixel(Ctx, x + i, y + j, Color_Background);
                                     // Paint_DrawPoint(x + i, y + j, Color_Background, DOT_PIXEL_DFT, DOT_STYLE_DFT);
                                 }
                             }
@@ -716,15 +1136,15 @@ void Paint_DrawString_CN(UWORD Xstart, UWORD Ystart, const char * pString, cFONT
                         for (i = 0; i < font->Width; i++) {
                             if (FONT_BACKGROUND == Color_Background) { //this process is to speed up the scan
                                 if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
+                                    PaintCtx_SetPixel(Ctx, x + i, y + j, Color_Foreground);
                                     // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
                                 }
                             } else {
                                 if (*ptr & (0x80 >> (i % 8))) {
-                                    Paint_SetPixel(x + i, y + j, Color_Foreground);
+                                    PaintCtx_SetPixel(Ctx, x + i, y + j, Color_Foreground);
                                     // Paint_DrawPoint(x + i, y + j, Color_Foreground, DOT_PIXEL_DFT, DOT_STYLE_DFT);
                                 } else {
-                                    Paint_SetPixel(x + i, y + j, Color_Background);
+                                    PaintCtx_SetPixel(Ctx, x + i, y + j, Color_Background);
                                     // Paint_DrawPoint(x + i, y + j, Color_Background, DOT_PIXEL_DFT, DOT_STYLE_DFT);
                                 }
                             }
@@ -757,36 +1177,18 @@ parameter:
     Color_Foreground : Select the foreground color
     Color_Background : Select the background color
 ******************************************************************************/
-#define  ARRAY_LEN 255
-void Paint_DrawNum(UWORD Xpoint, UWORD Ypoint, int32_t Nummber,
+void PaintCtx_DrawNum(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, int32_t Nummber,
                    sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
 {
+    char Str[FORMAT_INT_SIZE];
 
-    int16_t Num_Bit = 0, Str_Bit = 0;
-    uint8_t Str_Array[ARRAY_LEN] = {0}, Num_Array[ARRAY_LEN] = {0};
-    uint8_t *pStr = Str_Array;
-
-    if (Xpoint > Paint.Width || Ypoint > Paint.Height) {
+    if (Xpoint > Ctx->Width || Ypoint > Ctx->Height) {
         Debug("Paint_DisNum Input exceeds the normal display range\r\n");
         return;
     }
 
-    //Converts a number to a string
-    while (Nummber) {
-        Num_Array[Num_Bit] = Nummber % 10 + '0';
-        Num_Bit++;
-        Nummber /= 10;
-    }
-
-    //The string is inverted
-    while (Num_Bit > 0) {
-        Str_Array[Str_Bit] = Num_Array[Num_Bit - 1];
-        Str_Bit ++;
-        Num_Bit --;
-    }
-
-    //show
-    Paint_DrawString_EN(Xpoint, Ypoint, (const char*)pStr, Font, Color_Background, Color_Foreground);
+    Format_Int(Str, sizeof(Str), Nummber);
+    PaintCtx_DrawString_EN(Ctx, Xpoint, Ypoint, Str, Font, Color_Background, Color_Foreground);
 }
 
 /******************************************************************************
@@ -798,23 +1200,17 @@ parameter:
     Font             ：A structure pointer that displays a character size
     Color_Foreground : Select the foreground color
     Color_Background : Select the background color
+info:
+    Drawn as "hh:mm:ss" with Paint_DrawString_EN(), every character takes
+    one font cell.
 ******************************************************************************/
-void Paint_DrawTime(UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font,
+void PaintCtx_DrawTime(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font,
                     UWORD Color_Foreground, UWORD Color_Background)
 {
-    uint8_t value[10] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'};
-
-    UWORD Dx = Font->Width;
+    char Str[FORMAT_HHMMSS_SIZE];
 
-    //Write data into the cache
-    Paint_DrawChar(Xstart                           , Ystart, value[pTime->Hour / 10], Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx                      , Ystart, value[pTime->Hour % 10], Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx  + Dx / 4 + Dx / 2   , Ystart, ':'                    , Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx * 2 + Dx / 2         , Ystart, value[pTime->Min / 10] , Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx * 3 + Dx / 2         , Ystart, value[pTime->Min % 10] , Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx * 4 + Dx / 2 - Dx / 4, Ystart, ':'                    , Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx * 5                  , Ystart, value[pTime->Sec / 10] , Font, Color_Background, Color_Foreground);
-    Paint_DrawChar(Xstart + Dx * 6                  , Ystart, value[pTime->Sec % 10] , Font, Color_Background, Color_Foreground);
+    Format_HHMMSS(Str, sizeof(Str), pTime->Hour, pTime->Min, pTime->Sec);
+    PaintCtx_DrawString_EN(Ctx, Xstart, Ystart, Str, Font, Color_Foreground, Color_Background);
 }
 
 /******************************************************************************
@@ -825,19 +1221,120 @@ info:
     Use a computer to convert the image into a corresponding array,
     and then embed the array directly into Imagedata.cpp as a .c file.
 ******************************************************************************/
-void Paint_DrawBitMap(const unsigned char* image_buffer)
+void PaintCtx_DrawBitMap(PaintContext *Ctx, const unsigned char* image_buffer)
 {
-    UWORD x, y;
-    UDOUBLE Addr = 0;
+    memcpy(Ctx->Image, image_buffer, (UDOUBLE)Ctx->WidthByte * Ctx->HeightByte);
+}
 
-    for (y = 0; y < Paint.HeightByte; y++) {
-        for (x = 0; x < Paint.WidthByte; x++) {//8 pixel =  1 byte
-            Addr = x + y * Paint.WidthByte;
-            Paint.Image[Addr] = (unsigned char)image_buffer[Addr];
+/******************************************************************************
+function:	Display a PackBits compressed bitmap
+parameter:
+    rle_buffer ：Compressed picture data, see tools/assets.py --rle
+info:
+    Decodes until the framebuffer is full, the stream carries no length.
+    Control byte n = 0~127 copies the next n+1 bytes, n = 129~255 repeats
+    the next byte 257-n times, 128 is skipped.
+******************************************************************************/
+void PaintCtx_DrawBitMap_RLE(PaintContext *Ctx, const unsigned char* rle_buffer)
+{
+    UDOUBLE Size = (UDOUBLE)Ctx->WidthByte * Ctx->HeightByte;
+    UDOUBLE Pos = 0;
+    while (Pos < Size) {
+        UBYTE n = *rle_buffer++;
+        if (n < 128) {
+            UDOUBLE Run = (UDOUBLE)n + 1;
+            UDOUBLE Len = (Run < Size - Pos) ? Run : Size - Pos;
+            memcpy(Ctx->Image + Pos, rle_buffer, Len);
+            rle_buffer += Run;
+            Pos += Len;
+        } else if (n > 128) {
+            UDOUBLE Run = (UDOUBLE)(257 - n);
+            UDOUBLE Len = (Run < Size - Pos) ? Run : Size - Pos;
+            memset(Ctx->Image + Pos, *rle_buffer++, Len);
+            Pos += Len;
         }
     }
 }
 
+/******************************************************************************
+function:	Draw a PackBits compressed part of the framebuffer
+parameter:
+    Xstart   : X of the first pixel in the framebuffer, a multiple of 8
+    Ystart   : Y of the first row in the framebuffer
+    W_Region : Width in pixels, a multiple of 8
+    H_Region : Height in rows
+    rle_buffer : Compressed rows of the region, W_Region/8 bytes each
+    rle_size   : Length of the compressed data
+return: 1 if the region was filled, 0 if it lies outside the framebuffer,
+        the image is not 1-bpp or the data ends too early
+info:
+    Like PaintCtx_DrawBitMap_RLE() but the data comes
+    from the UART link: every length is checked, nothing is read behind
+    rle_size. Framebuffer coordinates ignore Rotate and Mirror.
+    The run headers are walked once before anything is written, so a
+    rejected region leaves the framebuffer untouched.
+******************************************************************************/
+UBYTE PaintCtx_DrawRegion_RLE(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, UWORD W_Region, UWORD H_Region,
+                              const unsigned char* rle_buffer, UWORD rle_size)
+{
+    if (Ctx->Scale != 2 || Xstart % 8 != 0 || W_Region % 8 != 0 || W_Region == 0 || H_Region == 0 ||
+        Xstart / 8 + W_Region / 8 > Ctx->WidthByte || Ystart + H_Region > Ctx->HeightByte)
+        return 0;
+
+    UWORD RowBytes = W_Region / 8;
+    UDOUBLE Size = (UDOUBLE)RowBytes * H_Region;
+    UDOUBLE Pos = 0;
+    UDOUBLE In = 0;
+
+    // Dry run: the runs must cover the region with the data at hand
+    while (Pos < Size) {
+        if (In >= rle_size)
+            return 0;
+        UBYTE n = rle_buffer[In++];
+        if (n < 128) {
+            UDOUBLE Run = (UDOUBLE)n + 1;
+            if (rle_size - In < ((Run < Size - Pos) ? Run : Size - Pos))
+                return 0;
+            In += Run;
+            Pos += Run;
+        } else if (n > 128) {
+            if (In >= rle_size)
+                return 0;
+            In++;
+            Pos += 257 - n;
+        }
+    }
+
+    Pos = 0;
+    In = 0;
+    UBYTE Value = 0, Literal = 0;
+    UWORD Count = 0;                // Bytes left in the current run
+    while (Pos < Size) {
+        if (Count == 0) {
+            UBYTE n = rle_buffer[In++];
+            if (n == 128)
+                continue;
+            Literal = n < 128;
+            Count = Literal ? n + 1 : 257 - n;
+            if (!Literal)
+                Value = rle_buffer[In++];
+        }
+        // Copy the run up to the end of the current row
+        UWORD Column = Pos % RowBytes;
+        UWORD Len = RowBytes - Column < Count ? RowBytes - Column : Count;
+        UBYTE *Dst = Ctx->Image + (UDOUBLE)(Ystart + Pos / RowBytes) * Ctx->WidthByte + Xstart / 8 + Column;
+        if (Literal) {
+            memcpy(Dst, rle_buffer + In, Len);
+            In += Len;
+        } else {
+            memset(Dst, Value, Len);
+        }
+        Count -= Len;
+        Pos += Len;
+    }
+    return 1;
+}
+
 /******************************************************************************
 function:	Display image
 parameter:
@@ -847,7 +1344,7 @@ parameter:
     xEnd             ：Image width
     yEnd             : Image height
 ******************************************************************************/
-void Paint_DrawImage(const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image) 
+void PaintCtx_DrawImage(PaintContext *Ctx, const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image) 
 {
     UWORD x, y;
 	UWORD w_byte=(W_Image%8)?(W_Image/8)+1:W_Image/8;
@@ -856,8 +1353,258 @@ void Paint_DrawImage(const unsigned char *image_buffer, UWORD xStart, UWORD ySta
     for (y = 0; y < H_Image; y++) {
         for (x = 0; x < w_byte; x++) {//8 pixel =  1 byte
             Addr = x + y * w_byte;
-			pAddr=x+(xStart/8)+((y+yStart)*Paint.WidthByte);
-            Paint.Image[pAddr] = (unsigned char)image_buffer[Addr];
+			pAddr=x+(xStart/8)+((y+yStart)*Ctx->WidthByte);
+            Ctx->Image[pAddr] = (unsigned char)image_buffer[Addr];
         }
     }
 }
+
+/******************************************************************************
+function:	Fetch 32 bits of a 1-bpp row starting at an arbitrary bit
+parameter:
+    row      : First byte of the row
+    bit      : Bit position, may be negative or beyond the row
+    row_byte : Bytes in the row, bits outside of it read as 0
+******************************************************************************/
+static UDOUBLE Paint_FetchBits(const UBYTE *row, int32_t bit, UWORD row_byte)
+{
+    int32_t byte = (bit >= 0) ? bit / 8 : -((7 - bit) / 8);
+    uint64_t v = 0;
+    for (UBYTE i = 0; i < 5; i++) {
+        int32_t n = byte + i;
+        v = (v << 8) | ((n >= 0 && n < row_byte) ? row[n] : 0);
+    }
+    return (UDOUBLE)(v >> (8 - (bit - byte * 8)));
+}
+
+/******************************************************************************
+function:	Mask of the bits [lo, hi) of a 32-bit window, MSB first
+******************************************************************************/
+static UDOUBLE Paint_WindowMask(int32_t lo, int32_t hi)
+{
+    UDOUBLE from = (lo <= 0) ? 0xFFFFFFFF : (lo >= 32) ? 0 : (0xFFFFFFFF >> lo);
+    UDOUBLE to = (hi >= 32) ? 0xFFFFFFFF : (hi <= 0) ? 0 : ~(0xFFFFFFFF >> hi);
+    return from & to;
+}
+
+/******************************************************************************
+function:	Blit a 1-bpp image at any position of the framebuffer
+parameter:
+    image_buffer ：Image start address, rows of (W_Image + 7) / 8 bytes
+    mask_buffer  ：Optional mask in the same layout, only pixels whose mask
+                   bit is 1 are changed. NULL changes the whole rectangle
+    xStart       : X starting coordinate in the framebuffer, any bit position
+    yStart       : Y starting coordinate in the framebuffer
+    W_Image      ：Image width
+    H_Image      : Image height
+    Rop          : How source and framebuffer are combined
+info:
+    Like Paint_DrawImage() the coordinates address the framebuffer directly,
+    independent of rotation and mirroring. The image is clipped to the
+    framebuffer, so xStart and yStart may also be negative. Every row is
+    processed in 32-bit windows aligned to the framebuffer bytes.
+******************************************************************************/
+void PaintCtx_BlitImage(PaintContext *Ctx, const unsigned char *image_buffer, const unsigned char *mask_buffer,
+                     int16_t xStart, int16_t yStart, UWORD W_Image, UWORD H_Image, PAINT_ROP Rop)
+{
+    if (Ctx->Scale != 2) {
+        Debug("Paint_BlitImage only supports scale 2\r\n");
+        return;
+    }
+
+    //Clip to the framebuffer
+    int32_t sx = 0, sy = 0;
+    int32_t dx0 = xStart, dy0 = yStart;
+    int32_t w = W_Image, h = H_Image;
+    if (dx0 < 0) { sx = -dx0; w += dx0; dx0 = 0; }
+    if (dy0 < 0) { sy = -dy0; h += dy0; dy0 = 0; }
+    if (dx0 + w > Ctx->WidthMemory)  w = Ctx->WidthMemory - dx0;
+    if (dy0 + h > Ctx->HeightMemory) h = Ctx->HeightMemory - dy0;
+    if (w <= 0 || h <= 0)
+        return;
+
+    UWORD src_byte = (W_Image % 8) ? (W_Image / 8) + 1 : W_Image / 8;
+    int32_t dx1 = dx0 + w;
+    int32_t db0 = dx0 / 8, db1 = (dx1 + 7) / 8;
+
+    for (int32_t y = 0; y < h; y++) {
+        const UBYTE *src = image_buffer + (sy + y) * src_byte;
+        const UBYTE *msk = mask_buffer ? mask_buffer + (sy + y) * src_byte : NULL;
+        UBYTE *dst = Ctx->Image + (UDOUBLE)(dy0 + y) * Ctx->WidthByte;
+
+        for (int32_t db = db0; db < db1; db += 4) {
+            int32_t bit = db * 8;
+            UDOUBLE cover = Paint_WindowMask(dx0 - bit, dx1 - bit);
+            UDOUBLE S = Paint_FetchBits(src, bit - dx0 + sx, src_byte);
+            if (msk)
+                cover &= Paint_FetchBits(msk, bit - dx0 + sx, src_byte);
+            if (cover == 0)
+                continue;
+
+            UBYTE n = (db1 - db < 4) ? db1 - db : 4;
+            UDOUBLE D = 0;
+            for (UBYTE i = 0; i < 4; i++)
+                D = (D << 8) | (i < n ? dst[db + i] : 0);
+
+            UDOUBLE R;
+            switch (Rop) {
+            case ROP_AND:    R = D & S; break;
+            case ROP_OR:     R = D | S; break;
+            case ROP_XOR:    R = D ^ S; break;
+            case ROP_INVERT: R = ~S;    break;
+            default:         R = S;     break;
+            }
+            D = (D & ~cover) | (R & cover);
+
+            for (UBYTE i = 0; i < n; i++)
+                dst[db + i] = (UBYTE)(D >> (24 - 8 * i));
+        }
+    }
+}
+
+/******************************************************************************
+function: Default context
+info:
+    The original API, every call draws into the global Paint
+******************************************************************************/
+void Paint_NewImage(UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD Color)
+{
+    PaintCtx_NewImage(&Paint, image, Width, Height, Rotate, Color);
+}
+
+void Paint_SelectImage(UBYTE *image)
+{
+    PaintCtx_SelectImage(&Paint, image);
+}
+
+void Paint_SetRotate(UWORD Rotate)
+{
+    PaintCtx_SetRotate(&Paint, Rotate);
+}
+
+void Paint_SetMirroring(UBYTE mirror)
+{
+    PaintCtx_SetMirroring(&Paint, mirror);
+}
+
+void Paint_SetScale(UBYTE scale)
+{
+    PaintCtx_SetScale(&Paint, scale);
+}
+
+void Paint_SetGlyphCache(GLYPH_CACHE *Cache)
+{
+    PaintCtx_SetGlyphCache(&Paint, Cache);
+}
+
+UBYTE Paint_MapPoint(UWORD Xpoint, UWORD Ypoint, UWORD *X, UWORD *Y)
+{
+    return PaintCtx_MapPoint(&Paint, Xpoint, Ypoint, X, Y);
+}
+
+void Paint_SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color)
+{
+    PaintCtx_SetPixel(&Paint, Xpoint, Ypoint, Color);
+}
+
+UWORD Paint_GetPixel(UWORD Xpoint, UWORD Ypoint)
+{
+    return PaintCtx_GetPixel(&Paint, Xpoint, Ypoint);
+}
+
+void Paint_Clear(UWORD Color)
+{
+    PaintCtx_Clear(&Paint, Color);
+}
+
+void Paint_ClearWindows(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
+{
+    PaintCtx_ClearWindows(&Paint, Xstart, Ystart, Xend, Yend, Color);
+}
+
+void Paint_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color, DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_FillWay)
+{
+    PaintCtx_DrawPoint(&Paint, Xpoint, Ypoint, Color, Dot_Pixel, Dot_FillWay);
+}
+
+void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style)
+{
+    PaintCtx_DrawLine(&Paint, Xstart, Ystart, Xend, Yend, Color, Line_width, Line_Style);
+}
+
+void Paint_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
+{
+    PaintCtx_DrawRectangle(&Paint, Xstart, Ystart, Xend, Yend, Color, Line_width, Draw_Fill);
+}
+
+void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
+{
+    PaintCtx_DrawCircle(&Paint, X_Center, Y_Center, Radius, Color, Line_width, Draw_Fill);
+}
+
+void Paint_FillPolygon(const int16_t *Xpoints, const int16_t *Ypoints, UBYTE Points, UWORD Color)
+{
+    PaintCtx_FillPolygon(&Paint, Xpoints, Ypoints, Points, Color);
+}
+
+void Paint_DrawChar(UWORD Xpoint, UWORD Ypoint, const char Acsii_Char, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    PaintCtx_DrawChar(&Paint, Xpoint, Ypoint, Acsii_Char, Font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawString_EN(UWORD Xstart, UWORD Ystart, const char * pString, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    PaintCtx_DrawString_EN(&Paint, Xstart, Ystart, pString, Font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawChar_Gray(UWORD Xpoint, UWORD Ypoint, const char Acsii_Char, const sFONT_GRAY* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    PaintCtx_DrawChar_Gray(&Paint, Xpoint, Ypoint, Acsii_Char, Font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawString_Gray(UWORD Xstart, UWORD Ystart, const char * pString, const sFONT_GRAY* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    PaintCtx_DrawString_Gray(&Paint, Xstart, Ystart, pString, Font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawString_CN(UWORD Xstart, UWORD Ystart, const char * pString, cFONT* font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    PaintCtx_DrawString_CN(&Paint, Xstart, Ystart, pString, font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawNum(UWORD Xpoint, UWORD Ypoint, int32_t Nummber, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    PaintCtx_DrawNum(&Paint, Xpoint, Ypoint, Nummber, Font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawTime(UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background)
+{
+    PaintCtx_DrawTime(&Paint, Xstart, Ystart, pTime, Font, Color_Foreground, Color_Background);
+}
+
+void Paint_DrawBitMap(const unsigned char* image_buffer)
+{
+    PaintCtx_DrawBitMap(&Paint, image_buffer);
+}
+
+void Paint_DrawBitMap_RLE(const unsigned char* rle_buffer)
+{
+    PaintCtx_DrawBitMap_RLE(&Paint, rle_buffer);
+}
+
+UBYTE Paint_DrawRegion_RLE(UWORD Xstart, UWORD Ystart, UWORD W_Region, UWORD H_Region,
+                           const unsigned char* rle_buffer, UWORD rle_size)
+{
+    return PaintCtx_DrawRegion_RLE(&Paint, Xstart, Ystart, W_Region, H_Region, rle_buffer, rle_size);
+}
+
+void Paint_DrawImage(const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image)
+{
+    PaintCtx_DrawImage(&Paint, image_buffer, xStart, yStart, W_Image, H_Image);
+}
+
+void Paint_BlitImage(const unsigned char *image_buffer, const unsigned char *mask_buffer,
+                     int16_t xStart, int16_t yStart, UWORD W_Image, UWORD H_Image, PAINT_ROP Rop)
+{
+    PaintCtx_BlitImage(&Paint, image_buffer, mask_buffer, xStart, yStart, W_Image, H_Image, Rop);
+}
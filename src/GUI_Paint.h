@@ -82,8 +82,13 @@
 #include "DEV_Config.h"
 #include "fonts/fonts.h"
 
+typedef struct _tGlyphCache GLYPH_CACHE;
+
 /**
  * Image attributes
+ * Every PaintCtx_*() function draws into the context it is given, so several
+ * buffers can be drawn at the same time (one context per task). The Paint_*()
+ * functions draw into the default context Paint.
 **/
 typedef struct {
     UBYTE *Image;
@@ -97,7 +102,9 @@ typedef struct {
     UWORD WidthByte;
     UWORD HeightByte;
     UWORD Scale;
-} PAINT;
+    GLYPH_CACHE *Cache;     // Optional, kept by PaintCtx_NewImage()
+} PaintContext;
+typedef PaintContext PAINT;
 extern PAINT Paint;
 
 /**
@@ -175,6 +182,22 @@ typedef enum {
     DRAW_FILL_FULL,
 } DRAW_FILL;
 
+/**
+ * Maximum number of corners of Paint_FillPolygon()
+**/
+#define PAINT_POLYGON_POINTS    16
+
+/**
+ * How Paint_BlitImage() combines image and framebuffer
+**/
+typedef enum {
+    ROP_COPY = 0,       // dst = src
+    ROP_AND,            // dst = dst & src
+    ROP_OR,             // dst = dst | src
+    ROP_XOR,            // dst = dst ^ src
+    ROP_INVERT,         // dst = ~src
+} PAINT_ROP;
+
 /**
  * Custom structure of a time attribute
 **/
@@ -189,11 +212,53 @@ typedef struct {
 extern PAINT_TIME sPaint_time;
 
 //init and Clear
+void PaintCtx_NewImage(PaintContext *Ctx, UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD Color);
+void PaintCtx_SelectImage(PaintContext *Ctx, UBYTE *image);
+void PaintCtx_SetRotate(PaintContext *Ctx, UWORD Rotate);
+void PaintCtx_SetMirroring(PaintContext *Ctx, UBYTE mirror);
+void PaintCtx_SetGlyphCache(PaintContext *Ctx, GLYPH_CACHE *Cache);
+UBYTE PaintCtx_MapPoint(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, UWORD *X, UWORD *Y);
+void PaintCtx_SetPixel(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, UWORD Color);
+UWORD PaintCtx_GetPixel(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint);
+void PaintCtx_SetScale(PaintContext *Ctx, UBYTE scale);
+
+void PaintCtx_Clear(PaintContext *Ctx, UWORD Color);
+void PaintCtx_ClearWindows(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color);
+
+//Drawing
+void PaintCtx_DrawPoint(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, UWORD Color, DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_FillWay);
+void PaintCtx_DrawLine(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style);
+void PaintCtx_DrawRectangle(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
+void PaintCtx_DrawCircle(PaintContext *Ctx, UWORD X_Center, UWORD Y_Center, UWORD Radius, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
+void PaintCtx_FillPolygon(PaintContext *Ctx, const int16_t *Xpoints, const int16_t *Ypoints, UBYTE Points, UWORD Color);
+
+//Display string
+void PaintCtx_DrawChar(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, const char Acsii_Char, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+void PaintCtx_DrawString_EN(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, const char * pString, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+void PaintCtx_DrawChar_Gray(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, const char Acsii_Char, const sFONT_GRAY* Font, UWORD Color_Foreground, UWORD Color_Background);
+void PaintCtx_DrawString_Gray(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, const char * pString, const sFONT_GRAY* Font, UWORD Color_Foreground, UWORD Color_Background);
+void PaintCtx_DrawString_CN(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, const char * pString, cFONT* font, UWORD Color_Foreground, UWORD Color_Background);
+void PaintCtx_DrawNum(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, int32_t Nummber, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+void PaintCtx_DrawTime(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+
+//pic
+void PaintCtx_DrawBitMap(PaintContext *Ctx, const unsigned char* image_buffer);
+void PaintCtx_DrawBitMap_RLE(PaintContext *Ctx, const unsigned char* rle_buffer);
+UBYTE PaintCtx_DrawRegion_RLE(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, UWORD W_Region, UWORD H_Region,
+                              const unsigned char* rle_buffer, UWORD rle_size);
+void PaintCtx_DrawImage(PaintContext *Ctx, const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image);
+void PaintCtx_BlitImage(PaintContext *Ctx, const unsigned char *image_buffer, const unsigned char *mask_buffer,
+                        int16_t xStart, int16_t yStart, UWORD W_Image, UWORD H_Image, PAINT_ROP Rop);
+
+//Default context
 void Paint_NewImage(UBYTE *image, UWORD Width, UWORD Height, UWORD Rotate, UWORD Color);
 void Paint_SelectImage(UBYTE *image);
 void Paint_SetRotate(UWORD Rotate);
 void Paint_SetMirroring(UBYTE mirror);
+void Paint_SetGlyphCache(GLYPH_CACHE *Cache);
+UBYTE Paint_MapPoint(UWORD Xpoint, UWORD Ypoint, UWORD *X, UWORD *Y);
 void Paint_SetPixel(UWORD Xpoint, UWORD Ypoint, UWORD Color);
+UWORD Paint_GetPixel(UWORD Xpoint, UWORD Ypoint);
 void Paint_SetScale(UBYTE scale);
 
 void Paint_Clear(UWORD Color);
@@ -204,17 +269,25 @@ void Paint_DrawPoint(UWORD Xpoint, UWORD Ypoint, UWORD Color, DOT_PIXEL Dot_Pixe
 void Paint_DrawLine(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style);
 void Paint_DrawRectangle(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
 void Paint_DrawCircle(UWORD X_Center, UWORD Y_Center, UWORD Radius, UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill);
+void Paint_FillPolygon(const int16_t *Xpoints, const int16_t *Ypoints, UBYTE Points, UWORD Color);
 
 //Display string
 void Paint_DrawChar(UWORD Xstart, UWORD Ystart, const char Acsii_Char, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
 void Paint_DrawString_EN(UWORD Xstart, UWORD Ystart, const char * pString, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
+void Paint_DrawChar_Gray(UWORD Xstart, UWORD Ystart, const char Acsii_Char, const sFONT_GRAY* Font, UWORD Color_Foreground, UWORD Color_Background);
+void Paint_DrawString_Gray(UWORD Xstart, UWORD Ystart, const char * pString, const sFONT_GRAY* Font, UWORD Color_Foreground, UWORD Color_Background);
 void Paint_DrawString_CN(UWORD Xstart, UWORD Ystart, const char * pString, cFONT* font, UWORD Color_Foreground, UWORD Color_Background);
 void Paint_DrawNum(UWORD Xpoint, UWORD Ypoint, int32_t Nummber, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
 void Paint_DrawTime(UWORD Xstart, UWORD Ystart, PAINT_TIME *pTime, sFONT* Font, UWORD Color_Foreground, UWORD Color_Background);
 
 //pic
 void Paint_DrawBitMap(const unsigned char* image_buffer);
+void Paint_DrawBitMap_RLE(const unsigned char* rle_buffer);
+UBYTE Paint_DrawRegion_RLE(UWORD Xstart, UWORD Ystart, UWORD W_Region, UWORD H_Region,
+                           const unsigned char* rle_buffer, UWORD rle_size);
 void Paint_DrawImage(const unsigned char *image_buffer, UWORD xStart, UWORD yStart, UWORD W_Image, UWORD H_Image); 
+void Paint_BlitImage(const unsigned char *image_buffer, const unsigned char *mask_buffer,
+                     int16_t xStart, int16_t yStart, UWORD W_Image, UWORD H_Image, PAINT_ROP Rop);
 
 #endif
 
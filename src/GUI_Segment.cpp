@@ -0,0 +1,209 @@
+/******************************************************************************
+* | File      	:   GUI_Segment.cpp
+* | Function    :   Seven-segment digits of any height
+* | Info        :
+*   See GUI_Segment.h
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-07-09
+* | Info        :
+*
+******************************************************************************/
+#include "GUI_Segment.h"
+
+/**
+ * Segment bits, a = top, then clockwise, g = middle
+ *
+ *    aaa
+ *   f   b
+ *    ggg
+ *   e   c
+ *    ddd
+**/
+#define SEG_A   0x01
+#define SEG_B   0x02
+#define SEG_C   0x04
+#define SEG_D   0x08
+#define SEG_E   0x10
+#define SEG_F   0x20
+#define SEG_G   0x40
+
+static const UBYTE Segment_Digits[10] = {
+    SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F,          // 0
+    SEG_B | SEG_C,                                          // 1
+    SEG_A | SEG_B | SEG_D | SEG_E | SEG_G,                  // 2
+    SEG_A | SEG_B | SEG_C | SEG_D | SEG_G,                  // 3
+    SEG_B | SEG_C | SEG_F | SEG_G,                          // 4
+    SEG_A | SEG_C | SEG_D | SEG_F | SEG_G,                  // 5
+    SEG_A | SEG_C | SEG_D | SEG_E | SEG_F | SEG_G,          // 6
+    SEG_A | SEG_B | SEG_C,                                  // 7
+    SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F | SEG_G,  // 8
+    SEG_A | SEG_B | SEG_C | SEG_D | SEG_F | SEG_G,          // 9
+};
+
+/**
+ * Proportions of a character of the given height, in pixels
+**/
+typedef struct {
+    int16_t Width;      // Digit width
+    int16_t Half;       // Half the stroke, keeps the segment tips on whole pixels
+    int16_t Gap;        // Space between neighbouring segment tips
+    int16_t Space;      // Space between characters
+} SEGMENT_METRICS;
+
+static void Segment_Metrics(UWORD Height, SEGMENT_METRICS *m)
+{
+    m->Half = (Height + 8) / 16;
+    m->Width = Height * 11 / 20;
+    m->Gap = (m->Half + 2) / 3;
+    m->Space = 2 * m->Half;
+}
+
+/******************************************************************************
+function: A horizontal segment, pointed at both ends
+parameter:
+    X0, X1 : Tips
+    Yc     : Center line
+    Half   : Half the stroke
+******************************************************************************/
+static void Segment_Horizontal(PaintContext *Ctx, int16_t X0, int16_t X1, int16_t Yc, int16_t Half, UWORD Color)
+{
+    const int16_t Xs[6] = {X0, (int16_t)(X0 + Half), (int16_t)(X1 - Half), X1, (int16_t)(X1 - Half), (int16_t)(X0 + Half)};
+    const int16_t Ys[6] = {Yc, (int16_t)(Yc - Half), (int16_t)(Yc - Half), Yc, (int16_t)(Yc + Half), (int16_t)(Yc + Half)};
+    PaintCtx_FillPolygon(Ctx, Xs, Ys, 6, Color);
+}
+
+/******************************************************************************
+function: A vertical segment, pointed at both ends
+parameter:
+    Xc     : Center line
+    Y0, Y1 : Tips
+    Half   : Half the stroke
+******************************************************************************/
+static void Segment_Vertical(PaintContext *Ctx, int16_t Xc, int16_t Y0, int16_t Y1, int16_t Half, UWORD Color)
+{
+    const int16_t Xs[6] = {Xc, (int16_t)(Xc + Half), (int16_t)(Xc + Half), Xc, (int16_t)(Xc - Half), (int16_t)(Xc - Half)};
+    const int16_t Ys[6] = {Y0, (int16_t)(Y0 + Half), (int16_t)(Y1 - Half), Y1, (int16_t)(Y1 - Half), (int16_t)(Y0 + Half)};
+    PaintCtx_FillPolygon(Ctx, Xs, Ys, 6, Color);
+}
+
+static void Segment_Square(PaintContext *Ctx, int16_t X0, int16_t Y0, int16_t Size, UWORD Color)
+{
+    const int16_t Xs[4] = {X0, (int16_t)(X0 + Size), (int16_t)(X0 + Size), X0};
+    const int16_t Ys[4] = {Y0, Y0, (int16_t)(Y0 + Size), (int16_t)(Y0 + Size)};
+    PaintCtx_FillPolygon(Ctx, Xs, Ys, 4, Color);
+}
+
+/******************************************************************************
+function: Width of a character
+parameter:
+    Acsii_Char : Character
+    Height     : Character height in pixels
+return: Width without the space to the next character, 0 if it can't be drawn
+******************************************************************************/
+UWORD Segment_CharWidth(const char Acsii_Char, UWORD Height)
+{
+    SEGMENT_METRICS m;
+    if (Height < SEGMENT_MIN_HEIGHT)
+        return 0;
+    Segment_Metrics(Height, &m);
+    if (Acsii_Char == ':')
+        return 2 * m.Half;
+    if ((Acsii_Char >= '0' && Acsii_Char <= '9') || Acsii_Char == '-' || Acsii_Char == ' ')
+        return m.Width;
+    return 0;
+}
+
+/******************************************************************************
+function: Width of a string drawn with Segment_DrawString()
+******************************************************************************/
+UWORD Segment_StringWidth(const char *pString, UWORD Height)
+{
+    SEGMENT_METRICS m;
+    UWORD Width = 0;
+    if (Height < SEGMENT_MIN_HEIGHT)
+        return 0;
+    Segment_Metrics(Height, &m);
+    for (; *pString != '\0'; pString++) {
+        UWORD w = Segment_CharWidth(*pString, Height);
+        if (w == 0)
+            continue;
+        if (Width > 0)
+            Width += m.Space;
+        Width += w;
+    }
+    return Width;
+}
+
+/******************************************************************************
+function: Draw a character
+parameter:
+    Xstart     : X coordinate of the left edge
+    Ystart     : Y coordinate of the top edge
+    Acsii_Char : '0' ... '9', ':', '-' or ' '
+    Height     : Character height in pixels, at least SEGMENT_MIN_HEIGHT
+    Color      : Color of the segments, the background is left alone
+return: Width of the character, see Segment_CharWidth()
+******************************************************************************/
+UWORD Segment_DrawChar(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, const char Acsii_Char, UWORD Height, UWORD Color)
+{
+    SEGMENT_METRICS m;
+    UWORD Width = Segment_CharWidth(Acsii_Char, Height);
+    if (Width == 0) {
+        Debug("Segment_DrawChar: unsupported character or height\r\n");
+        return 0;
+    }
+    Segment_Metrics(Height, &m);
+
+    int16_t X = Xstart, Y = Ystart, H = m.Half, G = m.Gap;
+    if (Acsii_Char == ':') {
+        //Two dots, a sixth of the height above and below the middle
+        Segment_Square(Ctx, X, Y + Height / 2 - Height / 6 - H, 2 * H, Color);
+        Segment_Square(Ctx, X, Y + Height / 2 + Height / 6 - H, 2 * H, Color);
+        return Width;
+    }
+
+    UBYTE Segments;
+    if (Acsii_Char == '-')
+        Segments = SEG_G;
+    else if (Acsii_Char == ' ')
+        Segments = 0;
+    else
+        Segments = Segment_Digits[Acsii_Char - '0'];
+
+    //Center lines of the strokes
+    int16_t Left = X + H, Right = X + Width - H;
+    int16_t Top = Y + H, Middle = Y + Height / 2, Bottom = Y + Height - H;
+
+    if (Segments & SEG_A) Segment_Horizontal(Ctx, Left + G, Right - G, Top, H, Color);
+    if (Segments & SEG_G) Segment_Horizontal(Ctx, Left + G, Right - G, Middle, H, Color);
+    if (Segments & SEG_D) Segment_Horizontal(Ctx, Left + G, Right - G, Bottom, H, Color);
+    if (Segments & SEG_F) Segment_Vertical(Ctx, Left, Top + G, Middle - G, H, Color);
+    if (Segments & SEG_B) Segment_Vertical(Ctx, Right, Top + G, Middle - G, H, Color);
+    if (Segments & SEG_E) Segment_Vertical(Ctx, Left, Middle + G, Bottom - G, H, Color);
+    if (Segments & SEG_C) Segment_Vertical(Ctx, Right, Middle + G, Bottom - G, H, Color);
+    return Width;
+}
+
+/******************************************************************************
+function: Draw a string on one line
+parameter:
+    See Segment_DrawChar(), unsupported characters are skipped
+return: Width of the string, see Segment_StringWidth()
+******************************************************************************/
+UWORD Segment_DrawString(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, const char *pString, UWORD Height, UWORD Color)
+{
+    SEGMENT_METRICS m;
+    UWORD X = Xstart;
+    if (Height < SEGMENT_MIN_HEIGHT)
+        return 0;
+    Segment_Metrics(Height, &m);
+    for (; *pString != '\0'; pString++) {
+        if (Segment_CharWidth(*pString, Height) == 0)
+            continue;
+        if (X > Xstart)
+            X += m.Space;
+        X += Segment_DrawChar(Ctx, X, Ystart, *pString, Height, Color);
+    }
+    return X - Xstart;
+}
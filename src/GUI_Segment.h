@@ -0,0 +1,34 @@
+/******************************************************************************
+* | File      	:   GUI_Segment.h
+* | Function    :   Seven-segment digits of any height
+* | Info        :
+*   Draws 0-9, ':', '-' and ' ' as filled segment polygons, so a clock face
+*   of any size costs a few hundred bytes of code instead of a font file.
+*   Every segment is a hexagon filled with PaintCtx_FillPolygon(), i.e. with
+*   masked spans along the framebuffer lines instead of one bit test per
+*   glyph pixel.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-07-09
+* | Info        :
+*   Width, stroke and gaps are derived from the height. Characters outside
+*   the canvas are clipped, other characters are skipped.
+*
+******************************************************************************/
+#ifndef __GUI_SEGMENT_H
+#define __GUI_SEGMENT_H
+
+#include "DEV_Config.h"
+#include "GUI_Paint.h"
+
+/**
+ * Smallest height whose segments don't collapse
+**/
+#define SEGMENT_MIN_HEIGHT      12
+
+UWORD Segment_CharWidth(const char Acsii_Char, UWORD Height);
+UWORD Segment_StringWidth(const char *pString, UWORD Height);
+UWORD Segment_DrawChar(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, const char Acsii_Char, UWORD Height, UWORD Color);
+UWORD Segment_DrawString(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, const char *pString, UWORD Height, UWORD Color);
+
+#endif
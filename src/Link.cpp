@@ -0,0 +1,213 @@
+#include "Link.h"
+#include "DayriseLog.h"
+#include <driver/uart.h>
+#include <string.h>
+#include <freertos/task.h>
+
+static QueueHandle_t uartEvents;    // Ereignisse des UART-Treibers
+static QueueHandle_t messages;      // Fertige Nachrichten für den Render-Task
+static PROTOCOL_PARSER parser;      // Gehört allein dem Link-Task
+static LinkStats stats;
+static volatile uint32_t lastActivity;  // millis() der letzten empfangenen Bytes
+static volatile bool telemetryRequested;
+static volatile uint16_t telemetryInterval;
+static bool regionDropped;          // Dem laufenden Update fehlt ein Ausschnitt
+
+/**
+ * @brief Legt eine Nachricht in die Queue. Ist sie voll, wartet der Link-Task kurz, in
+ * der Zeit füllt sich nur der Ringpuffer des Treibers. Es wird keine Nachricht aus der
+ * Queue verdrängt, sie könnte ein Ausschnitt sein.
+ *
+ * Die Ausschnitte eines Updates gehören zusammen. Fehlt einer, werden auch die
+ * folgenden bis einschließlich dem mit PROTOCOL_REGION_REFRESH verworfen, damit das
+ * Display kein Bild mit Loch refresht.
+ */
+static void Link_Queue(const LinkMessage *message) {
+    if (message->Type != PROTOCOL_MSG_REGION) {
+        if (xQueueSend(messages, message, pdMS_TO_TICKS(LINK_QUEUE_WAIT_MS)) != pdTRUE) {
+            stats.QueueDrops++;
+        }
+        return;
+    }
+    bool last = (message->Region.Header.Flags & PROTOCOL_REGION_REFRESH) != 0;
+    if (!regionDropped && xQueueSend(messages, message, pdMS_TO_TICKS(LINK_QUEUE_WAIT_MS)) == pdTRUE) {
+        return;
+    }
+    if (!regionDropped) {
+        stats.QueueDrops++;
+    }
+    stats.RegionDrops++;
+    regionDropped = !last;
+}
+
+/**
+ * @brief Wird vom Parser für jeden vollständigen Frame mit gültiger CRC aufgerufen.
+ * Dekodiert die Nachricht und reicht sie an den Render-Task weiter (siehe Link_Queue()).
+ */
+static void Link_OnFrame(void *arg, const PROTOCOL_FRAME *frame) {
+    // Die Anfrage nach Telemetrie ändert nichts am Bild und darf nicht mit den
+    // Nachrichten zusammengefasst werden, sie wird von loop() abgeholt
+    PROTOCOL_TELEMETRY_REQUEST request;
+    if (Protocol_DecodeTelemetryRequest(frame, &request)) {
+        telemetryInterval = request.Interval;
+        telemetryRequested = true;
+        return;
+    }
+
+    LinkMessage message;
+    message.Type = frame->Type;
+    const uint8_t *data;
+    uint16_t len;
+    if (Protocol_DecodeRegion(frame, &message.Region.Header, &data, &len)) {
+        // Passt immer, der Parser nimmt keine längeren Frames an
+        message.Region.Len = len;
+        memcpy(message.Region.Data, data, len);
+    } else if (!Protocol_DecodeTime(frame, &message.Time) && !Protocol_DecodeAlarm(frame, &message.Alarm)) {
+        return;
+    }
+    Link_Queue(&message);
+}
+
+/**
+ * @brief Verwirft alles Empfangene nach einem Überlauf. Der Frame, in dem die
+ * Bytes fehlen, würde sonst erst an seiner CRC scheitern.
+ */
+static void Link_Reset() {
+    uart_flush_input(LINK_UART);
+    xQueueReset(uartEvents);
+    Protocol_Idle(&parser, Link_OnFrame, NULL);
+}
+
+/**
+ * @brief Link-Task: Wartet auf Ereignisse des UART-Treibers und zerlegt die
+ * empfangenen Bytes in Frames.
+ */
+static void Link_Task(void *param) {
+    uart_event_t event;
+    uint8_t buffer[128];
+    for (;;) {
+        if (xQueueReceive(uartEvents, &event, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        switch (event.type) {
+        case UART_DATA: {
+            size_t left = event.size;
+            while (left > 0) {
+                int len = uart_read_bytes(LINK_UART, buffer, left < sizeof(buffer) ? left : sizeof(buffer), 0);
+                if (len <= 0) {
+                    break;
+                }
+                stats.Bytes += len;
+                lastActivity = millis();
+                left -= len;
+                Protocol_Feed(&parser, buffer, len, Link_OnFrame, NULL);
+            }
+            // Die Leitung ist still, ein angefangener Frame kommt nicht mehr
+            if (event.timeout_flag) {
+                Protocol_Idle(&parser, Link_OnFrame, NULL);
+            }
+            break;
+        }
+        case UART_FIFO_OVF:
+            stats.FifoOverflows++;
+            Link_Reset();
+            break;
+        case UART_BUFFER_FULL:
+            stats.BufferFull++;
+            Link_Reset();
+            break;
+        case UART_FRAME_ERR:
+        case UART_PARITY_ERR:
+            stats.LineErrors++;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Richtet UART2 mit dem Treiber von ESP-IDF ein und startet den Link-Task.
+ * 
+ * @return QueueHandle_t Die Queue mit den empfangenen LinkMessage, NULL bei einem Fehler
+ */
+QueueHandle_t Link_Start() {
+    uart_config_t config = {};
+    config.baud_rate = LINK_BAUD;
+    config.data_bits = UART_DATA_8_BITS;
+    config.parity = UART_PARITY_DISABLE;
+    config.stop_bits = UART_STOP_BITS_1;
+    config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+
+    Protocol_Init(&parser);
+    messages = xQueueCreate(LINK_MESSAGES, sizeof(LinkMessage));
+    if (messages == NULL ||
+        uart_driver_install(LINK_UART, LINK_RX_BUFFER, 0, LINK_EVENTS, &uartEvents, 0) != ESP_OK ||
+        uart_param_config(LINK_UART, &config) != ESP_OK ||
+        uart_set_pin(LINK_UART, LINK_TX_PIN, LINK_RX_PIN, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK) {
+        LOG_ERROR("UART2 konnte nicht eingerichtet werden");
+        return NULL;
+    }
+    xTaskCreatePinnedToCore(Link_Task, "link", 3072, NULL, LINK_PRIORITY, NULL, LINK_CORE);
+    return messages;
+}
+
+/**
+ * @brief Kopiert die Zähler des Empfangs und des Parsers.
+ */
+void Link_GetStats(LinkStats *linkStats, PROTOCOL_STATS *parserStats) {
+    linkStats->Bytes = stats.Bytes;
+    linkStats->FifoOverflows = stats.FifoOverflows;
+    linkStats->BufferFull = stats.BufferFull;
+    linkStats->LineErrors = stats.LineErrors;
+    linkStats->QueueDrops = stats.QueueDrops;
+    linkStats->RegionDrops = stats.RegionDrops;
+    *parserStats = parser.Stats;
+}
+
+/**
+ * @brief Prüft, ob der Empfang ruht: Seit LINK_IDLE_MS kam nichts an, der Ringpuffer
+ * ist leer und kein Frame ist angefangen. Erst dann darf der ESP32 schlafen gehen.
+ */
+bool Link_IsIdle() {
+    size_t buffered = 0;
+    uart_get_buffered_data_len(LINK_UART, &buffered);
+    return buffered == 0 && parser.Count == 0 && millis() - lastActivity >= LINK_IDLE_MS;
+}
+
+/**
+ * @brief Meldet, dass der ESP32 von der RX-Leitung geweckt wurde. Das Weck-Byte des
+ * Masters geht dabei verloren, der Frame folgt erst PROTOCOL_WAKE_MS später. Bis dahin
+ * muss der ESP32 wach bleiben, sonst würde er vom Frame geweckt und dessen erstes Byte fehlen.
+ */
+void Link_Wake() {
+    lastActivity = millis();
+}
+
+/**
+ * @brief Holt eine Anfrage des Masters nach Telemetrie ab.
+ *
+ * @param interval Gewünschte Sekunden zwischen zwei Berichten, 0 = nur ein Bericht
+ * @return true, wenn seit dem letzten Aufruf eine Anfrage kam
+ */
+bool Link_TelemetryRequested(uint16_t *interval) {
+    if (!telemetryRequested) {
+        return false;
+    }
+    telemetryRequested = false;
+    *interval = telemetryInterval;
+    return true;
+}
+
+/**
+ * @brief Sendet einen Frame an den Master. Kehrt erst zurück, wenn er vollständig
+ * gesendet ist, damit der ESP32 danach schlafen gehen darf.
+ *
+ * @return true, wenn der Frame gesendet wurde
+ */
+bool Link_Send(const uint8_t *frame, uint16_t len) {
+    if (len == 0 || uart_write_bytes(LINK_UART, frame, len) != len) {
+        return false;
+    }
+    return uart_wait_tx_done(LINK_UART, pdMS_TO_TICKS(100)) == ESP_OK;
+}
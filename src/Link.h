@@ -0,0 +1,70 @@
+#ifndef __LINK_H
+#define __LINK_H
+
+#include "DEV_Config.h"
+#include "DayriseProtocol.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+/**
+ * Die UART-Verbindung zum Master. Ein eigener Task nimmt die Bytes aus dem
+ * Ringpuffer des UART-Treibers, zerlegt sie in Frames und legt die Nachrichten
+ * in eine Queue. Der Empfang hängt dadurch nicht mehr davon ab, wie lange das
+ * Zeichnen und Refreshen des Displays dauert.
+ * In die Gegenrichtung schickt das Display über LINK_TX_PIN Telemetrie an den Master.
+ */
+#define LINK_UART           UART_NUM_2
+#define LINK_RX_PIN         16
+#define LINK_TX_PIN         17
+#define LINK_BAUD           115200
+#define LINK_RX_BUFFER      1024    // Ringpuffer des Treibers, wird vom UART-Interrupt gefüllt
+#define LINK_EVENTS         16      // Ereignisse des Treibers (Daten, Überläufe, ...)
+#define LINK_MESSAGES       8       // Nachrichten an den Render-Task
+#define LINK_QUEUE_WAIT_MS  50      // So lange wartet der Link-Task auf Platz in der Queue (< LINK_RX_BUFFER bei LINK_BAUD)
+#define LINK_CORE           0
+#define LINK_PRIORITY       3       // Über dem Driver-Task, damit der Ringpuffer nicht vollläuft
+#define LINK_IDLE_MS        20      // So lange still, bevor der Empfang als ruhend gilt (> PROTOCOL_WAKE_MS)
+
+/**
+ * Ein Ausschnitt des Bildspeichers (PROTOCOL_MSG_REGION), die Daten sind noch komprimiert
+ */
+#define LINK_REGION_DATA    (PROTOCOL_MAX_PAYLOAD - PROTOCOL_REGION_SIZE)
+
+typedef struct {
+    PROTOCOL_REGION Header;
+    uint16_t Len;
+    uint8_t Data[LINK_REGION_DATA];
+} LinkRegion;
+
+/**
+ * Eine empfangene Nachricht, Type ist PROTOCOL_MSG_TIME, PROTOCOL_MSG_ALARM oder PROTOCOL_MSG_REGION
+ */
+typedef struct {
+    uint8_t Type;
+    union {
+        PROTOCOL_TIME Time;
+        PROTOCOL_ALARM Alarm;
+        LinkRegion Region;
+    };
+} LinkMessage;
+
+/**
+ * Zähler des Empfangs
+ */
+typedef struct {
+    volatile uint32_t Bytes;
+    volatile uint32_t FifoOverflows;    // Hardware-FIFO übergelaufen, der Task kam nicht schnell genug dran
+    volatile uint32_t BufferFull;       // Ringpuffer des Treibers voll
+    volatile uint32_t LineErrors;       // Frame- und Paritätsfehler auf der Leitung
+    volatile uint32_t QueueDrops;       // Nachrichten verworfen, weil der Render-Task nicht abholt
+    volatile uint32_t RegionDrops;      // Ausschnitte verworfen, bis zum nächsten mit PROTOCOL_REGION_REFRESH
+} LinkStats;
+
+QueueHandle_t Link_Start(void);
+void Link_GetStats(LinkStats *linkStats, PROTOCOL_STATS *parserStats);
+bool Link_IsIdle(void);
+void Link_Wake(void);
+bool Link_TelemetryRequested(uint16_t *interval);
+bool Link_Send(const uint8_t *frame, uint16_t len);
+
+#endif
@@ -0,0 +1,57 @@
+#include "Power.h"
+#include "Link.h"
+#include <esp_sleep.h>
+#include <esp_timer.h>
+#include <driver/gpio.h>
+
+static PowerStats stats;
+
+/**
+ * @brief Schickt den ESP32 in den Light Sleep. Der Aufrufer muss vorher sicherstellen,
+ * dass kein Task mehr arbeitet (siehe sleepIfIdle() in main.cpp), sonst hält dieser mit an.
+ *
+ * @param maxMs Spätestens nach dieser Zeit weckt der Timer
+ * @param waitForBusy true, wenn gerade ein Refresh läuft, dann weckt auch dessen Ende
+ * @return PowerWake Wodurch der ESP32 aufgewacht ist
+ */
+PowerWake Power_Sleep(uint32_t maxMs, bool waitForBusy) {
+    // Angefangene Ausgaben auf dem seriellen Monitor erst fertig senden
+    Serial.flush();
+
+    // Die RX-Leitung ist in Ruhe high, das Startbit des Weck-Bytes zieht sie auf low.
+    // BUSY ist während des Refreshs low und geht am Ende auf high.
+    gpio_wakeup_enable((gpio_num_t)LINK_RX_PIN, GPIO_INTR_LOW_LEVEL);
+    if (waitForBusy) {
+        gpio_wakeup_enable((gpio_num_t)EPD_BUSY_PIN, GPIO_INTR_HIGH_LEVEL);
+    }
+    esp_sleep_enable_gpio_wakeup();
+    esp_sleep_enable_timer_wakeup((uint64_t)maxMs * 1000);
+
+    int64_t start = esp_timer_get_time();
+    esp_light_sleep_start();
+    stats.sleepUs += esp_timer_get_time() - start;
+    stats.sleeps++;
+
+    gpio_wakeup_disable((gpio_num_t)LINK_RX_PIN);
+    if (waitForBusy) {
+        gpio_wakeup_disable((gpio_num_t)EPD_BUSY_PIN);
+    }
+
+    if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER) {
+        stats.timerWakes++;
+        return POWER_WAKE_TIMER;
+    }
+    if (waitForBusy && gpio_get_level((gpio_num_t)EPD_BUSY_PIN)) {
+        stats.busyWakes++;
+        return POWER_WAKE_BUSY;
+    }
+    stats.uartWakes++;
+    return POWER_WAKE_UART;
+}
+
+/**
+ * @brief Kopiert die Zähler für die Zeit im Schlaf.
+ */
+void Power_GetStats(PowerStats *powerStats) {
+    *powerStats = stats;
+}
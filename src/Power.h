@@ -0,0 +1,38 @@
+#ifndef __POWER_H
+#define __POWER_H
+
+#include "DEV_Config.h"
+
+/**
+ * Light Sleep zwischen den Updates. Der ESP32 schläft, solange weder ein
+ * Bild gezeichnet noch übertragen wird und der Empfang ruht. Geweckt wird er
+ * von der RX-Leitung zum Master (PROTOCOL_WAKE), vom BUSY-Pin des Displays,
+ * wenn ein Refresh fertig wird, oder vom Timer.
+ *
+ * Im Light Sleep laufen RAM, Register und Tasks nach dem Aufwachen einfach
+ * weiter, nur die Takte stehen. Der UART empfängt in dieser Zeit nichts.
+ */
+#define POWER_POLL_MS       5       // Wartezeit, wenn gerade nicht geschlafen werden darf
+
+typedef enum {
+    POWER_WAKE_NONE = 0,    // Nicht geschlafen
+    POWER_WAKE_TIMER,
+    POWER_WAKE_UART,
+    POWER_WAKE_BUSY,
+} PowerWake;
+
+/**
+ * Zähler für die Zeit im Schlaf
+ */
+typedef struct {
+    uint64_t sleepUs;       // Summe der Zeit im Light Sleep
+    uint32_t sleeps;
+    uint32_t uartWakes;
+    uint32_t busyWakes;
+    uint32_t timerWakes;
+} PowerStats;
+
+PowerWake Power_Sleep(uint32_t maxMs, bool waitForBusy);
+void Power_GetStats(PowerStats *stats);
+
+#endif
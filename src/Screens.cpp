@@ -0,0 +1,95 @@
+#include "Screens.h"
+#include "EPD.h"
+#include "GUI_Format.h"
+#include "images/ImageData.h"
+#include <string.h>
+
+/**
+ * @brief Zentriert den Text horizontal.
+ * 
+ * @param fontSize in Pixel
+ * @return int y-Position in Pixel
+ */
+int getHorizontalCenter(int fontSize) {
+    return (EPD_3IN52_WIDTH/2)-(fontSize/2);
+}
+
+/**
+ * @brief Get the Vertical Center object
+ * 
+ * @param fontHeight Die Höhe des Fonts (siehe in /fonts Ordner, dort ist diese Konfiguriert)
+ * @param letters Anzahl der Biuchstaben
+ * @return int 
+ */
+int getVerticalCenter(int fontHeight, int letters) {
+    return (EPD_3IN52_WIDTH/2)-((fontHeight*letters)/2);
+}
+
+/**
+ * @brief Zeichnet den Splashscreen.
+ */
+void Screen_Splash(PaintContext *Ctx) {
+    PaintCtx_Clear(Ctx, WHITE);
+    PaintCtx_DrawBitMap_RLE(Ctx, dayrise_splashscreen_rle);
+}
+
+/**
+ * @brief Zeigt Indikator und verbleibende Zeit auf Display an, ob ein Alarm aktiv ist oder nicht.
+ * Der Indikator ist ein ausgefüllter Kreis (aktiv) oder nur die Kontur eines Kreises (nicht aktiv).
+ * 
+ * @param isActive 1 = Alarm aktiv, 0 = Alarm nicht aktiv
+ * @param timeRemaining Die verbleibende Zeit bis zum Alarm
+ */
+void Screen_ActiveAlarm(PaintContext *Ctx, UBYTE isActive, const char *timeRemaining) {
+    if(isActive) {
+        PaintCtx_DrawCircle(Ctx, 35, 22, 4, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
+        PaintCtx_DrawString_EN(Ctx, 48, 14, timeRemaining, &FontRoboto13, WHITE, BLACK);
+    } else {
+        PaintCtx_DrawCircle(Ctx, 35, 22, 4, BLACK, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
+        PaintCtx_DrawString_EN(Ctx, 48, 14, "No alarm", &FontRoboto13, WHITE, BLACK);
+    }
+}
+
+/**
+ * @brief Zeichnet die aktuelle Uhrzeit.
+ * 
+ * @param currentTime Die gesendet Uhrzeit vom Master
+ * @param alarmTime Die gesendete Alarmzeit vom Master, "-" wenn kein Alarm gesetzt ist
+ */
+void Screen_Time(PaintContext *Ctx, const char *currentTime, const char *alarmTime) {
+    Screen_ActiveAlarm(Ctx, strcmp(alarmTime, "-") != 0, alarmTime);
+    PaintCtx_DrawString_EN(Ctx, 35, getHorizontalCenter(80), currentTime, &FontRoboto72, WHITE, BLACK);
+}
+
+/**
+ * @brief Zeichnet die Weckzeiteinstellug.
+ * 
+ * @param alarmTime Die gesendete Alarmzeit vom Master
+ * @param alarmState Der gesendete Alarmstatus vom Master (0 = in Bearbeitung, 1 = abgeschlossen)
+ */
+void Screen_Alarm(PaintContext *Ctx, const char *alarmTime, UBYTE alarmState) {
+    if(alarmState) {
+        PaintCtx_DrawString_EN(Ctx, 35, 22, "Set alarm", &FontRoboto13, WHITE, BLACK);
+        PaintCtx_DrawString_EN(Ctx, 35, getHorizontalCenter(80), alarmTime, &FontRoboto72, WHITE, BLACK);
+    }
+}
+
+/**
+ * @brief Zeichnet den Bildschirm eines Zustands.
+ * 
+ * @param state Der Zustand, bei SCREEN_NONE bleibt das Bild leer
+ */
+void Screen_Draw(PaintContext *Ctx, const ScreenState *state) {
+    char time[FORMAT_HHMM_SIZE];
+    char remaining[FORMAT_HHMM_SIZE] = "-";
+
+    Format_HHMM(time, sizeof(time), state->hour, state->min);
+    if (state->mode == SCREEN_TIME) {
+        if (state->hasRemaining) {
+            Format_HHMM(remaining, sizeof(remaining), state->remainingHour, state->remainingMin);
+        }
+        Screen_Time(Ctx, time, remaining);
+    } else if (state->mode == SCREEN_ALARM) {
+        Screen_Alarm(Ctx, time, 1);
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef __SCREENS_H
+#define __SCREENS_H
+
+#include "GUI_Paint.h"
+
+/**
+ * Die Bildschirme des Weckers. Sie zeichnen nur in den übergebenen Kontext,
+ * damit sie auch auf dem PC gerendert werden können (siehe host/render.cpp).
+ */
+int getHorizontalCenter(int fontSize);
+int getVerticalCenter(int fontHeight, int letters);
+
+void Screen_Splash(PaintContext *Ctx);
+void Screen_ActiveAlarm(PaintContext *Ctx, UBYTE isActive, const char *timeRemaining);
+void Screen_Time(PaintContext *Ctx, const char *currentTime, const char *alarmTime);
+void Screen_Alarm(PaintContext *Ctx, const char *alarmTime, UBYTE alarmState);
+
+/**
+ * Was gerade auf dem Display zu sehen ist. Zwei gleiche Zustände ergeben das
+ * gleiche Bild, der Zustand wird deshalb nur neu gezeichnet, wenn er sich
+ * ändert. Ungenutzte Felder müssen 0 sein, damit memcmp() vergleichen kann.
+ */
+typedef enum {
+    SCREEN_NONE = 0,    // Noch keine Nachricht vom Master
+    SCREEN_TIME,        // Uhrzeit und verbleibende Zeit bis zum Alarm
+    SCREEN_ALARM,       // Weckzeit einstellen
+    SCREEN_REMOTE,      // Vom Master gesendete Ausschnitte (PROTOCOL_MSG_REGION), wird nicht gezeichnet
+} ScreenMode;
+
+typedef struct {
+    UBYTE mode;             // ScreenMode
+    UBYTE hour;             // Uhrzeit bzw. Weckzeit
+    UBYTE min;
+    UBYTE hasRemaining;     // Nur SCREEN_TIME: 0 = kein Alarm aktiv
+    UBYTE remainingHour;
+    UBYTE remainingMin;
+} ScreenState;
+
+void Screen_Draw(PaintContext *Ctx, const ScreenState *state);
+
+#endif
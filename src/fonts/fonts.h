@@ -21,9 +21,35 @@ typedef struct _tFont
   const uint8_t *table;
   uint16_t Width;
   uint16_t Height;
+  uint8_t First;      // Erstes Zeichen der Tabelle, 0 = ' ' (alle Fonts von dot-Factory)
+  uint8_t Last;       // Letztes Zeichen der Tabelle, 0 = '~'
   
 } sFONT;
 
+// Position eines Zeichens in der Tabelle, -1 wenn der Font es nicht enthält
+static inline int Font_GlyphIndex(const sFONT *Font, char c)
+{
+  uint8_t First = Font->First ? Font->First : ' ';
+  uint8_t Last = Font->Last ? Font->Last : '~';
+  if ((uint8_t)c < First || (uint8_t)c > Last)
+    return -1;
+  return (uint8_t)c - First;
+}
+
+// Kantengeglättete Zeichen eines sFONT, 2 bpp Deckung (0 = keine Tinte, 3 = volle Tinte),
+// so abgelegt wie im Framebuffer mit Paint_SetScale(4) und der Drehung Rotate.
+// Erzeugt mit tools/assets.py atlas, gezeichnet von PaintCtx_DrawString_Gray().
+typedef struct _tFontGray
+{
+  const uint8_t *table;
+  const sFONT *Mono;  // Größe der Zeichen, und für alles, was der Atlas nicht kann
+  uint16_t Rotate;    // Drehung der Zeichenfläche, für die der Atlas erzeugt wurde
+  uint16_t Rows;      // Framebuffer-Zeilen je Zeichen
+  uint16_t WidthByte; // Bytes je Framebuffer-Zeile, ein Vielfaches von 4
+  uint8_t First;
+  uint8_t Last;
+} sFONT_GRAY;
+
 //GB2312
 typedef struct                                          // 汉字字模数据结构
 {
@@ -51,6 +77,8 @@ extern sFONT Font16;
 extern sFONT Font12;
 extern sFONT Font8;
 
+extern sFONT_GRAY FontRoboto72_Gray;
+
 // extern const unsigned char Font16_Table[];
 
 #ifdef __cplusplus
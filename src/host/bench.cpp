@@ -0,0 +1,486 @@
+/******************************************************************************
+* | File      	:   bench.cpp
+* | Function    :   Micro-benchmarks of the Paint and font hot paths
+* | Info        :
+*   Host:    pio run -e bench -t exec
+*            .pio/build/bench/program [min_seconds] [name_filter]
+*   ESP32:   pio run -e bench_esp32 -t upload -t monitor
+*            Also times the upload of a 1-bpp and a 4 gray frame and of
+*            their LUTs over the SPI of the panel (EPD_*)
+*   Every primitive is timed for all rotations and scales 2/4/7, the result
+*   is one CSV line per case on stdout:
+*     bench,font,rotate,scale,cache,iterations,ns_per_op,cycles_per_op,bytes_per_op,mb_per_s
+*   cycles_per_op comes from the CPU cycle counter on the ESP32 and is 0 on
+*   the host. bytes_per_op and mb_per_s are filled for the cases that move a
+*   known amount of memory (Clear, DrawBitMap, GrayPlanes) and 0 otherwise,
+*   so the byte loops and the word kernels compare in MB/s. The iteration count is doubled until a case runs at least
+*   min_seconds, so the per-op numbers are comparable between commits.
+*----------------
+* |	This version:   V1.8
+* | Date        :   2023-07-21
+* | Info        :
+*   V1.8: Upload of the 1-bpp and the 4 gray frame on the ESP32
+*   V1.7: bytes_per_op and MB/s of the memory kernels
+*   V1.6: DrawNum/DrawTime
+*   V1.5: Seven-segment digits at the height of Roboto72
+*   V1.4: Dithering of a full frame
+*   V1.3: Anti-aliased text from the glyph atlas, atlas size on stderr
+*   V1.2: Bit plane split of the 4 gray frame
+*   V1.1: CSV suite of all primitives, on-target build
+*   V1.0: Byte loops against the word kernels of Paint_Clear()/DrawBitMap()
+*
+******************************************************************************/
+#include "../GUI_Paint.h"
+#include "../GUI_Cache.h"
+#include "../GUI_Atlas.h"
+#include "../GUI_Dither.h"
+#include "../GUI_Segment.h"
+#include "../EPD.h"
+#include "../images/ImageData.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef ARDUINO
+#include <time.h>
+#endif
+
+#ifdef ARDUINO
+#define BENCH_MIN_SECONDS   0.05
+#else
+#define BENCH_MIN_SECONDS   0.02
+#endif
+
+//Large enough for scale 7, which needs 3 bits per pixel plus one spare byte
+static UBYTE Image[EPD_3IN52_WIDTH * EPD_3IN52_HEIGHT / 2];
+static GLYPH_CACHE Cache;
+static UBYTE Splash[EPD_3IN52_WIDTH / 8 * EPD_3IN52_HEIGHT];     //Unpacked splash screen
+static UBYTE Planes[2][EPD_3IN52_WIDTH / 8 * EPD_3IN52_HEIGHT];  //4 gray frame as sent to 0x10/0x13
+static UBYTE GrayRow[EPD_3IN52_HEIGHT];                         //One source row of the dither cases
+static int16_t DitherScratch[DITHER_SCRATCH(EPD_3IN52_HEIGHT)];
+static volatile UBYTE Sink;
+
+static double MinSeconds = BENCH_MIN_SECONDS;
+static const char *Filter = NULL;
+
+/******************************************************************************
+function: Time sources
+******************************************************************************/
+static double Now(void)
+{
+#ifdef ARDUINO
+    return micros() * 1e-6;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+static UDOUBLE Cycles(void)
+{
+#ifdef ARDUINO
+    return ESP.getCycleCount();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Reference: the loops Paint_Clear() and Paint_DrawBitMap() used before
+**/
+static void Old_Clear(UWORD Color)
+{
+    if(Paint.Scale == 2 || Paint.Scale == 4) {
+        for (UWORD Y = 0; Y < Paint.HeightByte; Y++) {
+            for (UWORD X = 0; X < Paint.WidthByte; X++ ) {
+                UDOUBLE Addr = X + Y*Paint.WidthByte;
+                Paint.Image[Addr] = Color;
+            }
+        }
+    }
+    if(Paint.Scale == 7) {
+        Color = (UBYTE)Color;
+        UWORD Width = (Paint.WidthMemory * 3 % 8 == 0)? (Paint.WidthMemory * 3 / 8 ): (Paint.WidthMemory * 3 / 8 + 1);
+        for (UWORD Y = 0; Y < Paint.HeightByte; Y++) {
+            for (UWORD X = 0; X < Width; X++ ) {
+                UDOUBLE Addr = X + Y * Width;
+                if((X + Y * Width)%3 == 0)
+                    Paint.Image[Addr] = ((Color<<5) | (Color<<2) | (Color>>1));
+                else if((X + Y * Width)%3 == 1)
+                    Paint.Image[Addr] = ((Color<<7) | (Color<<4) | (Color<<1) | (Color>>2));
+                else if((X + Y * Width)%3 == 2)
+                    Paint.Image[Addr] = ((Color<<6) | (Color<<3) |  Color);
+            }
+        }
+    }
+}
+
+static void Old_DrawBitMap(const unsigned char* image_buffer)
+{
+    for (UWORD y = 0; y < Paint.HeightByte; y++) {
+        for (UWORD x = 0; x < Paint.WidthByte; x++) {
+            UDOUBLE Addr = x + y * Paint.WidthByte;
+            Paint.Image[Addr] = (unsigned char)image_buffer[Addr];
+        }
+    }
+}
+
+/**
+ * Reference: one test per pixel for the bit planes of EPD_3IN52_display_4Gray()
+**/
+static void Old_GrayPlanes(void)
+{
+    memset(Planes, 0, sizeof(Planes));
+    for (UDOUBLE Pixel = 0; Pixel < (UDOUBLE)EPD_3IN52_WIDTH * EPD_3IN52_HEIGHT; Pixel++) {
+        UBYTE Value = (Paint.Image[Pixel / 4] >> (6 - 2 * (Pixel % 4))) & 0x03;
+        if (Value & 0x02)
+            Planes[0][Pixel / 8] |= 0x80 >> (Pixel % 8);
+        if (Value & 0x01)
+            Planes[1][Pixel / 8] |= 0x80 >> (Pixel % 8);
+    }
+}
+
+static void GrayPlanes(void)
+{
+    const UBYTE *p = Paint.Image;
+    for (UWORD i = 0; i < EPD_3IN52_WIDTH * EPD_3IN52_HEIGHT / 16; i++, p += 4) {
+        UDOUBLE Pixels = ((UDOUBLE)p[0] << 24) | ((UDOUBLE)p[1] << 16) | ((UDOUBLE)p[2] << 8) | p[3];
+        UWORD High = EPD_3IN52_GrayPlane16(Pixels, 1), Low = EPD_3IN52_GrayPlane16(Pixels, 0);
+        Planes[0][2 * i] = High >> 8;
+        Planes[0][2 * i + 1] = High & 0xFF;
+        Planes[1][2 * i] = Low >> 8;
+        Planes[1][2 * i + 1] = Low & 0xFF;
+    }
+}
+
+/******************************************************************************
+function: Benchmark cases, one call is one operation
+parameter:
+    i : Iteration number, varies positions and colors a little
+******************************************************************************/
+static sFONT *CurFont;
+
+static UWORD Ink(UDOUBLE i)
+{
+    if (Paint.Scale == 2)
+        return (i & 1) ? BLACK : WHITE;
+    return i % 4;
+}
+
+static void Case_SetPixel(UDOUBLE i)
+{
+    Paint_SetPixel(i % Paint.Width, (i / Paint.Width) % Paint.Height, Ink(i));
+}
+
+static void Case_Clear(UDOUBLE i)            { Paint_Clear(Ink(i)); }
+static void Case_ClearByteLoop(UDOUBLE i)    { Old_Clear(Ink(i)); }
+static void Case_DrawBitMap(UDOUBLE i)       { Paint_DrawBitMap(Splash); }
+static void Case_DrawBitMapByteLoop(UDOUBLE i) { Old_DrawBitMap(Splash); }
+static void Case_DrawBitMapRLE(UDOUBLE i)    { Paint_DrawBitMap_RLE(dayrise_splashscreen_rle); }
+static void Case_GrayPlanes(UDOUBLE i)       { GrayPlanes(); }
+static void Case_GrayPlanesPixelLoop(UDOUBLE i) { Old_GrayPlanes(); }
+
+#ifdef ARDUINO
+//Bytes on the SPI of the panel, commands included
+#define EPD_FRAME_BYTES     (1 + EPD_3IN52_WIDTH * EPD_3IN52_HEIGHT / 8)
+#define EPD_4GRAY_BYTES     (2 * EPD_FRAME_BYTES)
+#define EPD_LUT_DU_BYTES    (5 + 56 + 42 + 42 + 56 + 42)
+#define EPD_LUT_4GRAY_BYTES (5 + 5 * 42)
+
+static void Case_EpdDisplay(UDOUBLE i)       { EPD_3IN52_display(Paint.Image); }
+static void Case_EpdDisplay4Gray(UDOUBLE i)  { EPD_3IN52_display_4Gray(Paint.Image); }
+static void Case_EpdLutDU(UDOUBLE i)         { EPD_3IN52_lut_DU(); }
+static void Case_EpdLut4Gray(UDOUBLE i)      { EPD_3IN52_lut_4Gray(); }
+#endif
+
+static void Case_DrawChar(UDOUBLE i)
+{
+    UWORD X = (i * CurFont->Width) % (Paint.Width - CurFont->Width);
+    UWORD Y = (i % 3) * ((Paint.Height - CurFont->Height) / 2);
+    Paint_DrawChar(X, Y, '0' + i % 10, CurFont, WHITE, BLACK);
+}
+
+static void Case_DrawCharGray(UDOUBLE i)
+{
+    const sFONT *Mono = FontRoboto72_Gray.Mono;
+    UWORD X = (i * Mono->Width) % (Paint.Width - Mono->Width);
+    UWORD Y = (i % 3) * ((Paint.Height - Mono->Height) / 2);
+    Paint_DrawChar_Gray(X, Y, '0' + i % 10, &FontRoboto72_Gray, BLACK, WHITE);
+}
+
+static void Case_DrawStringGray(UDOUBLE i)
+{
+    static const char *Texts[] = {"12:34", "07:45", "23:59"};
+    Paint_DrawString_Gray(i % 2, 0, Texts[i % 3], &FontRoboto72_Gray, WHITE, BLACK);
+}
+
+//A full canvas gradient, generated and dithered row by row
+static void Dither(DITHER_MODE Mode)
+{
+    DITHER Dither;
+    Dither_Begin(&Dither, &Paint, 0, 0, Paint.Width, Paint.Height, Mode, DitherScratch);
+    for (UWORD y = 0; y < Paint.Height; y++) {
+        for (UWORD x = 0; x < Paint.Width; x++)
+            GrayRow[x] = (x * 255 / Paint.Width + y) & 0xFF;
+        Dither_Row(&Dither, GrayRow);
+    }
+}
+
+static void Case_DitherNone(UDOUBLE i)       { Dither(DITHER_NONE); }
+static void Case_DitherBayer(UDOUBLE i)      { Dither(DITHER_BAYER); }
+static void Case_DitherFS(UDOUBLE i)         { Dither(DITHER_FLOYD_STEINBERG); }
+
+static void Case_DrawNum(UDOUBLE i)
+{
+    Paint_DrawNum(i % 2, 0, (int32_t)(i * 7919) - 100000, CurFont, BLACK, WHITE);
+}
+
+static void Case_DrawTime(UDOUBLE i)
+{
+    PAINT_TIME Time = {2023, 7, 10, (UBYTE)(i % 24), (UBYTE)(i % 60), (UBYTE)(i * 7 % 60)};
+    Paint_DrawTime(i % 2, 0, &Time, CurFont, WHITE, BLACK);
+}
+
+//Same height and positions as DrawChar/DrawString_EN of Roboto72
+static void Case_DrawCharSegment(UDOUBLE i)
+{
+    UWORD Width = Segment_CharWidth('8', FontRoboto72.Height);
+    UWORD X = (i * Width) % (Paint.Width - Width);
+    UWORD Y = (i % 3) * ((Paint.Height - FontRoboto72.Height) / 2);
+    Segment_DrawChar(&Paint, X, Y, '0' + i % 10, FontRoboto72.Height, BLACK);
+}
+
+static void Case_DrawStringSegment(UDOUBLE i)
+{
+    static const char *Texts[] = {"12:34", "07:45", "23:59"};
+    Segment_DrawString(&Paint, i % 2, 0, Texts[i % 3], FontRoboto72.Height, BLACK);
+}
+
+static void Case_DrawString(UDOUBLE i)
+{
+    static const char *Texts[] = {"12:34", "07:45", "23:59"};
+    UWORD X = (Paint.Width > 5 * CurFont->Width) ? (i % 2) : 0;
+    Paint_DrawString_EN(X, 0, Texts[i % 3], CurFont, WHITE, BLACK);
+}
+
+//A 1x1 dot covers the pixel left of and above its point, the lines start at 1 to stay on the canvas
+static void Case_LineH(UDOUBLE i)
+{
+    UWORD Y = 1 + i % (Paint.Height - 1);
+    Paint_DrawLine(1, Y, Paint.Width - 1, Y, Ink(i), DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+}
+
+static void Case_LineV(UDOUBLE i)
+{
+    UWORD X = 1 + i % (Paint.Width - 1);
+    Paint_DrawLine(X, 1, X, Paint.Height - 1, Ink(i), DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+}
+
+static void Case_LineDiagonal(UDOUBLE i)
+{
+    UWORD Y = 1 + i % (Paint.Height - 1);
+    Paint_DrawLine(1, Y, Paint.Width - 1, Paint.Height - Y, Ink(i), DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+}
+
+static void Case_RectEmpty(UDOUBLE i)
+{
+    UWORD X = 1 + i % 32, Y = 1 + i % 16;
+    Paint_DrawRectangle(X, Y, X + 100, Y + 60, Ink(i), DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
+}
+
+static void Case_RectFull(UDOUBLE i)
+{
+    UWORD X = 1 + i % 32, Y = 1 + i % 16;
+    Paint_DrawRectangle(X, Y, X + 100, Y + 60, Ink(i), DOT_PIXEL_1X1, DRAW_FILL_FULL);
+}
+
+static void Case_CircleEmpty(UDOUBLE i)
+{
+    Paint_DrawCircle(60 + i % 32, 60 + i % 16, 50, Ink(i), DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
+}
+
+static void Case_CircleFull(UDOUBLE i)
+{
+    Paint_DrawCircle(60 + i % 32, 60 + i % 16, 50, Ink(i), DOT_PIXEL_1X1, DRAW_FILL_FULL);
+}
+
+typedef void (*BENCH_FUNC)(UDOUBLE i);
+
+//Bytes of Run_Bytes(): one op writes the whole framebuffer of the canvas
+#define BENCH_FRAME     0xFFFFFFFF
+
+static UDOUBLE FrameBytes(void)
+{
+    if (Paint.Scale == 7)
+        return (UDOUBLE)((Paint.WidthMemory * 3 + 7) / 8) * Paint.HeightByte;
+    return (UDOUBLE)Paint.WidthByte * Paint.HeightByte;
+}
+
+/******************************************************************************
+function: Time one case and print its CSV line
+parameter:
+    Name   : Case name, also matched against the filter
+    Font   : Font name or "-"
+    Rotate : Canvas rotation
+    Scale  : Canvas scale
+    cache  : Whether the glyph cache is attached
+    Bytes  : Bytes one op moves, BENCH_FRAME or 0 if it is not a memory kernel
+    Func   : The case
+******************************************************************************/
+static void Run_Bytes(const char *Name, const char *Font, UWORD Rotate, UBYTE Scale, UBYTE cache,
+                      UDOUBLE Bytes, BENCH_FUNC Func)
+{
+    if (Filter != NULL && strstr(Name, Filter) == NULL)
+        return;
+
+    Paint_NewImage(Image, EPD_3IN52_WIDTH, EPD_3IN52_HEIGHT, Rotate, WHITE);
+    Paint_SetScale(Scale);
+    Paint_Clear(WHITE);
+    GlyphCache_Flush(&Cache);
+    Paint_SetGlyphCache(cache ? &Cache : NULL);
+    Func(0);    //Warm up, fills the glyph cache
+
+    UDOUBLE Iterations = 1;
+    double t;
+    UDOUBLE c;
+    for (;;) {
+        c = Cycles();
+        t = Now();
+        for (UDOUBLE i = 0; i < Iterations; i++) {
+            Func(i);
+            __asm__ __volatile__("" : : "r"(Paint.Image) : "memory");    //Keep the stores
+        }
+        t = Now() - t;
+        c = Cycles() - c;
+        if (t >= MinSeconds || Iterations >= (1UL << 30))
+            break;
+        Iterations *= 2;
+    }
+    Sink = Paint.Image[0];
+    if (Bytes == BENCH_FRAME)
+        Bytes = FrameBytes();
+
+    printf("%s,%s,%d,%d,%d,%lu,%.1f,%.1f,%lu,%.1f\r\n", Name, Font, Rotate, Scale, cache,
+           (unsigned long)Iterations, t * 1e9 / Iterations, (double)c / Iterations,
+           (unsigned long)Bytes, Bytes * (double)Iterations / t * 1e-6);
+}
+
+static void Run(const char *Name, const char *Font, UWORD Rotate, UBYTE Scale, UBYTE cache, BENCH_FUNC Func)
+{
+    Run_Bytes(Name, Font, Rotate, Scale, cache, 0, Func);
+}
+
+static void Bench_Run(void)
+{
+    static const UWORD Rotates[] = {ROTATE_0, ROTATE_90, ROTATE_180, ROTATE_270};
+    static const UBYTE Scales[] = {2, 4, 7};
+    static const struct {
+        const char *Name;
+        sFONT *Font;
+    } Fonts[] = {
+        {"Font8", &Font8}, {"Font12", &Font12}, {"Font16", &Font16}, {"Font20", &Font20},
+        {"Font24", &Font24}, {"Roboto13", &FontRoboto13}, {"Roboto48", &FontRoboto48},
+        {"Roboto72", &FontRoboto72},
+    };
+
+    GlyphCache_Init(&Cache, GLYPH_CACHE_BUDGET);
+    printf("bench,font,rotate,scale,cache,iterations,ns_per_op,cycles_per_op,bytes_per_op,mb_per_s\r\n");
+
+    for (UBYTE s = 0; s < sizeof(Scales); s++) {
+        UBYTE Scale = Scales[s];
+        //Memory kernels don't depend on the rotation
+        Run_Bytes("Clear", "-", ROTATE_270, Scale, 0, BENCH_FRAME, Case_Clear);
+        Run_Bytes("Clear_ByteLoop", "-", ROTATE_270, Scale, 0, BENCH_FRAME, Case_ClearByteLoop);
+
+        for (UBYTE r = 0; r < sizeof(Rotates) / sizeof(Rotates[0]); r++) {
+            UWORD Rotate = Rotates[r];
+            Run("SetPixel", "-", Rotate, Scale, 0, Case_SetPixel);
+            Run("DrawLine_H", "-", Rotate, Scale, 0, Case_LineH);
+            Run("DrawLine_V", "-", Rotate, Scale, 0, Case_LineV);
+            Run("DrawLine_Diagonal", "-", Rotate, Scale, 0, Case_LineDiagonal);
+            Run("DrawRectangle_Empty", "-", Rotate, Scale, 0, Case_RectEmpty);
+            Run("DrawRectangle_Full", "-", Rotate, Scale, 0, Case_RectFull);
+            Run("DrawCircle_Empty", "-", Rotate, Scale, 0, Case_CircleEmpty);
+            Run("DrawCircle_Full", "-", Rotate, Scale, 0, Case_CircleFull);
+
+            for (UBYTE f = 0; f < sizeof(Fonts) / sizeof(Fonts[0]); f++) {
+                CurFont = Fonts[f].Font;
+                //The glyph cache only serves scale 2
+                for (UBYTE cache = 0; cache <= (Scale == 2 ? 1 : 0); cache++) {
+                    Run("DrawChar", Fonts[f].Name, Rotate, Scale, cache, Case_DrawChar);
+                    Run("DrawString_EN", Fonts[f].Name, Rotate, Scale, cache, Case_DrawString);
+                }
+            }
+            Run("DrawChar_Segment", "Segment100", Rotate, Scale, 0, Case_DrawCharSegment);
+            Run("DrawString_Segment", "Segment100", Rotate, Scale, 0, Case_DrawStringSegment);
+        }
+    }
+
+    //The splash screen has the size of the 1-bpp framebuffer
+    Paint_NewImage(Splash, EPD_3IN52_WIDTH, EPD_3IN52_HEIGHT, ROTATE_270, WHITE);
+    Paint_DrawBitMap_RLE(dayrise_splashscreen_rle);
+    Run_Bytes("DrawBitMap", "-", ROTATE_270, 2, 0, BENCH_FRAME, Case_DrawBitMap);
+    Run_Bytes("DrawBitMap_ByteLoop", "-", ROTATE_270, 2, 0, BENCH_FRAME, Case_DrawBitMapByteLoop);
+    Run_Bytes("DrawBitMap_RLE", "-", ROTATE_270, 2, 0, BENCH_FRAME, Case_DrawBitMapRLE);
+
+    //Formatted text on the clock canvas
+    CurFont = &Font24;
+    for (UBYTE cache = 0; cache <= 1; cache++) {
+        Run("DrawNum", "Font24", ROTATE_270, 2, cache, Case_DrawNum);
+        Run("DrawTime", "Font24", ROTATE_270, 2, cache, Case_DrawTime);
+    }
+
+    //8-bit gray to the framebuffer, per frame
+    for (UBYTE s = 0; s < 2; s++) {
+        Run("Dither_None", "-", ROTATE_270, Scales[s], 0, Case_DitherNone);
+        Run("Dither_Bayer", "-", ROTATE_270, Scales[s], 0, Case_DitherBayer);
+        Run("Dither_FloydSteinberg", "-", ROTATE_270, Scales[s], 0, Case_DitherFS);
+    }
+
+    //Anti-aliased clock digits, compare DrawChar/DrawString_EN of Roboto72 at scale 2 and 4
+    Run("DrawChar_Gray", "Roboto72Gray", ROTATE_270, 4, 0, Case_DrawCharGray);
+    Run("DrawString_Gray", "Roboto72Gray", ROTATE_270, 4, 0, Case_DrawStringGray);
+    const sFONT *Mono = FontRoboto72_Gray.Mono;
+    UWORD Glyphs = FontRoboto72_Gray.Last - FontRoboto72_Gray.First + 1;
+    fprintf(stderr, "# Roboto72Gray: %u glyphs, %lu bytes atlas, %lu bytes at 1 bpp\r\n", Glyphs,
+            (unsigned long)Glyphs * FontRoboto72_Gray.Rows * FontRoboto72_Gray.WidthByte,
+            (unsigned long)Glyphs * Mono->Height * ((Mono->Width + 7) / 8));
+
+    //Upload preparation of a 4 gray frame, a 1-bpp frame is sent as it is.
+    //Compare the scale 2 and 4 rows above for the render cost.
+    Run_Bytes("GrayPlanes", "-", ROTATE_270, 4, 0, BENCH_FRAME, Case_GrayPlanes);
+    Run_Bytes("GrayPlanes_PixelLoop", "-", ROTATE_270, 4, 0, BENCH_FRAME, Case_GrayPlanesPixelLoop);
+
+#ifdef ARDUINO
+    //Upload cost of a 4 gray frame against a 1-bpp frame, the refresh itself is not timed.
+    //EPD_3IN52_display_4Gray() includes the bit plane split.
+    Run_Bytes("EPD_display", "-", ROTATE_270, 2, 0, EPD_FRAME_BYTES, Case_EpdDisplay);
+    Run_Bytes("EPD_display_4Gray", "-", ROTATE_270, 4, 0, EPD_4GRAY_BYTES, Case_EpdDisplay4Gray);
+    Run_Bytes("EPD_lut_DU", "-", ROTATE_270, 2, 0, EPD_LUT_DU_BYTES, Case_EpdLutDU);
+    Run_Bytes("EPD_lut_4Gray", "-", ROTATE_270, 4, 0, EPD_LUT_4GRAY_BYTES, Case_EpdLut4Gray);
+#endif
+}
+
+#ifdef ARDUINO
+void setup()
+{
+    DEV_Module_Init();      //Pins of the panel and Serial
+    delay(2000);
+    Bench_Run();
+}
+
+void loop()
+{
+    delay(1000);
+}
+#else
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+        MinSeconds = atof(argv[1]);
+    if (argc > 2)
+        Filter = argv[2];
+    Bench_Run();
+    return 0;
+}
+#endif
@@ -0,0 +1,281 @@
+/******************************************************************************
+* | File      	:   render.cpp
+* | Function    :   Host renderer for the display screens
+* | Info        :
+*   Draws a screen of Screens.cpp into a framebuffer on Linux and writes it
+*   as PBM or PNG, as it appears on the panel (ROTATE_270, 360 x 240).
+*   Build with PlatformIO:  pio run -e render
+*   Run:  .pio/build/render/program time 07:45 6h30m time.png
+*         .pio/build/render/program alarm 06:30 alarm.pbm
+*         .pio/build/render/program splash splash.pbm --compare golden.pbm
+*   With --compare the frame is checked pixel by pixel against a PBM file,
+*   the exit code is 1 if any pixel differs.
+*   pio run -e render -t golden compares all screens of test/golden/golden.txt
+*   against their golden PBMs (see tools/pio_golden.py).
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-06-26
+* | Info        :
+*
+******************************************************************************/
+#include "../GUI_Paint.h"
+#include "../GUI_Cache.h"
+#include "../Screens.h"
+#include "../EPD.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static UBYTE Image[EPD_3IN52_WIDTH / 8 * EPD_3IN52_HEIGHT];
+static GLYPH_CACHE Cache;
+
+/******************************************************************************
+function: PNG and zlib checksums
+******************************************************************************/
+static UDOUBLE Crc32(UDOUBLE crc, const UBYTE *data, UDOUBLE len)
+{
+    crc = ~crc;
+    for (UDOUBLE i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (UBYTE k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+static UDOUBLE Adler32(UDOUBLE adler, const UBYTE *data, UDOUBLE len)
+{
+    UDOUBLE a = adler & 0xFFFF, b = adler >> 16;
+    for (UDOUBLE i = 0; i < len; i++) {
+        a = (a + data[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
+static void Put32(UBYTE *p, UDOUBLE v)
+{
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static void WriteChunk(FILE *f, const char *type, const UBYTE *data, UDOUBLE len)
+{
+    UBYTE head[8];
+    Put32(head, len);
+    memcpy(head + 4, type, 4);
+    UDOUBLE crc = Crc32(Crc32(0, head + 4, 4), data, len);
+    UBYTE tail[4];
+    Put32(tail, crc);
+    fwrite(head, 1, 8, f);
+    fwrite(data, 1, len, f);
+    fwrite(tail, 1, 4, f);
+}
+
+/******************************************************************************
+function: Write the canvas as 1-bit grayscale PNG
+info:
+    The zlib stream uses stored (uncompressed) deflate blocks, which keeps
+    the writer free of dependencies
+******************************************************************************/
+static int WritePNG(const char *path, const UBYTE *pixels, UWORD Width, UWORD Height)
+{
+    UWORD RowBytes = (Width + 7) / 8;
+    UDOUBLE RawLen = (UDOUBLE)(RowBytes + 1) * Height;
+    UBYTE *Raw = (UBYTE *)calloc(RawLen, 1);
+    UDOUBLE Blocks = (RawLen + 65534) / 65535;
+    UBYTE *Z = (UBYTE *)malloc(2 + RawLen + Blocks * 5 + 4);
+    FILE *f = fopen(path, "wb");
+    if (Raw == NULL || Z == NULL || f == NULL) {
+        free(Raw);
+        free(Z);
+        if (f != NULL)
+            fclose(f);
+        return 0;
+    }
+
+    for (UWORD y = 0; y < Height; y++) {
+        UBYTE *row = Raw + (UDOUBLE)y * (RowBytes + 1);
+        row[0] = 0;     //Filter type None
+        for (UWORD x = 0; x < Width; x++)
+            if (pixels[(UDOUBLE)y * Width + x])
+                row[1 + x / 8] |= 0x80 >> (x % 8);     //1 = white
+    }
+
+    UDOUBLE n = 0;
+    Z[n++] = 0x78;
+    Z[n++] = 0x01;
+    for (UDOUBLE pos = 0; pos < RawLen; ) {
+        UDOUBLE len = RawLen - pos > 65535 ? 65535 : RawLen - pos;
+        Z[n++] = (pos + len == RawLen) ? 1 : 0;
+        Z[n++] = len & 0xFF;
+        Z[n++] = len >> 8;
+        Z[n++] = ~len & 0xFF;
+        Z[n++] = (~len >> 8) & 0xFF;
+        memcpy(Z + n, Raw + pos, len);
+        n += len;
+        pos += len;
+    }
+    Put32(Z + n, Adler32(1, Raw, RawLen));
+    n += 4;
+
+    static const UBYTE Signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    UBYTE IHDR[13];
+    Put32(IHDR, Width);
+    Put32(IHDR + 4, Height);
+    IHDR[8] = 1;        //Bit depth
+    IHDR[9] = 0;        //Grayscale
+    IHDR[10] = IHDR[11] = IHDR[12] = 0;
+    fwrite(Signature, 1, 8, f);
+    WriteChunk(f, "IHDR", IHDR, 13);
+    WriteChunk(f, "IDAT", Z, n);
+    WriteChunk(f, "IEND", NULL, 0);
+
+    free(Raw);
+    free(Z);
+    return fclose(f) == 0;
+}
+
+/******************************************************************************
+function: Write the canvas as binary PBM (P4)
+******************************************************************************/
+static int WritePBM(const char *path, const UBYTE *pixels, UWORD Width, UWORD Height)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL)
+        return 0;
+    fprintf(f, "P4\n%d %d\n", Width, Height);
+    for (UWORD y = 0; y < Height; y++) {
+        UBYTE row[(EPD_3IN52_HEIGHT + 7) / 8] = {0};
+        for (UWORD x = 0; x < Width; x++)
+            if (!pixels[(UDOUBLE)y * Width + x])
+                row[x / 8] |= 0x80 >> (x % 8);     //1 = black
+        fwrite(row, 1, (Width + 7) / 8, f);
+    }
+    return fclose(f) == 0;
+}
+
+/******************************************************************************
+function: Count the pixels that differ from a PBM file
+return: Number of differing pixels, -1 if the file can't be read or has
+        another size
+******************************************************************************/
+static long ComparePBM(const char *path, const UBYTE *pixels, UWORD Width, UWORD Height)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL)
+        return -1;
+    int w = 0, h = 0;
+    char magic[3] = {0};
+    if (fscanf(f, "%2s", magic) != 1 || strcmp(magic, "P4") != 0) {
+        fclose(f);
+        return -1;
+    }
+    for (int *field = &w; field != NULL; field = (field == &w) ? &h : NULL) {
+        int c;
+        while ((c = fgetc(f)) == '#' || c == ' ' || c == '\t' || c == '\r' || c == '\n')
+            if (c == '#')
+                while ((c = fgetc(f)) != '\n' && c != EOF);
+        ungetc(c, f);
+        if (fscanf(f, "%d", field) != 1) {
+            fclose(f);
+            return -1;
+        }
+    }
+    fgetc(f);       //Single whitespace before the raster
+    if (w != Width || h != Height) {
+        fclose(f);
+        return -1;
+    }
+
+    long diff = 0;
+    for (UWORD y = 0; y < Height; y++) {
+        UBYTE row[(EPD_3IN52_HEIGHT + 7) / 8];
+        if (fread(row, 1, (Width + 7) / 8, f) != (size_t)(Width + 7) / 8) {
+            fclose(f);
+            return -1;
+        }
+        for (UWORD x = 0; x < Width; x++) {
+            UBYTE black = (row[x / 8] >> (7 - x % 8)) & 1;
+            if (black == (pixels[(UDOUBLE)y * Width + x] ? 1 : 0))
+                diff++;
+        }
+    }
+    fclose(f);
+    return diff;
+}
+
+static int EndsWith(const char *s, const char *suffix)
+{
+    size_t n = strlen(s), m = strlen(suffix);
+    return n >= m && strcmp(s + n - m, suffix) == 0;
+}
+
+static void Usage(void)
+{
+    fprintf(stderr,
+            "usage: render splash <out.pbm|out.png> [--compare golden.pbm]\n"
+            "       render time <hh:mm> <remaining|-> <out> [--compare golden.pbm]\n"
+            "       render alarm <hh:mm> <out> [--compare golden.pbm]\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *Compare = NULL;
+    if (argc >= 3 && strcmp(argv[argc - 2], "--compare") == 0) {
+        Compare = argv[argc - 1];
+        argc -= 2;
+    }
+    if (argc < 3) {
+        Usage();
+        return 2;
+    }
+
+    Paint_NewImage(Image, EPD_3IN52_WIDTH, EPD_3IN52_HEIGHT, ROTATE_270, WHITE);
+    GlyphCache_Init(&Cache, GLYPH_CACHE_BUDGET);
+    Paint_SetGlyphCache(&Cache);
+    Paint_Clear(WHITE);
+
+    const char *Screen = argv[1];
+    const char *Out;
+    if (strcmp(Screen, "splash") == 0 && argc == 3) {
+        Screen_Splash(&Paint);
+        Out = argv[2];
+    } else if (strcmp(Screen, "time") == 0 && argc == 5) {
+        Screen_Time(&Paint, argv[2], argv[3]);
+        Out = argv[4];
+    } else if (strcmp(Screen, "alarm") == 0 && argc == 4) {
+        Screen_Alarm(&Paint, argv[2], 1);
+        Out = argv[3];
+    } else {
+        Usage();
+        return 2;
+    }
+
+    //The canvas as seen on the panel, one byte per pixel
+    UWORD Width = Paint.Width, Height = Paint.Height;
+    static UBYTE Pixels[EPD_3IN52_WIDTH * EPD_3IN52_HEIGHT];
+    for (UWORD y = 0; y < Height; y++)
+        for (UWORD x = 0; x < Width; x++)
+            Pixels[(UDOUBLE)y * Width + x] = Paint_GetPixel(x, y) == WHITE;
+
+    int ok = EndsWith(Out, ".png") ? WritePNG(Out, Pixels, Width, Height)
+                                   : WritePBM(Out, Pixels, Width, Height);
+    if (!ok) {
+        fprintf(stderr, "render: can't write %s\n", Out);
+        return 2;
+    }
+
+    if (Compare != NULL) {
+        long diff = ComparePBM(Compare, Pixels, Width, Height);
+        if (diff < 0) {
+            fprintf(stderr, "render: can't read %s or size differs\n", Compare);
+            return 2;
+        }
+        printf("%ld pixels differ from %s\n", diff, Compare);
+        return diff != 0;
+    }
+    return 0;
+}
@@ -32,8 +32,13 @@
 #ifndef _IMAGEDATA_H_
 #define _IMAGEDATA_H_
 
-extern const unsigned char dayrise_splashscreen[];
+// PackBits komprimiert, für EPD_3IN52_display_RLE() und Paint_DrawBitMap_RLE()
+extern const unsigned char dayrise_splashscreen_rle[];
 extern const unsigned char indicator_no_alarm[];
 
+// Größe von indicator_no_alarm in Pixel (für Paint_BlitImage)
+#define INDICATOR_NO_ALARM_WIDTH    25
+#define INDICATOR_NO_ALARM_HEIGHT   25
+
 #endif
 /* FILE END */
@@ -0,0 +1,158 @@
+// Erzeugt mit tools/assets.py aus splash.png, nicht von Hand bearbeiten
+// tools/assets.py image assets/splash.png --rotate 270 --rle --name dayrise_splashscreen_rle -o src/images/Splash.c
+// 240 x 360 Pixel im Framebuffer, 1 bpp, PackBits, 10800 bytes unpacked
+
+#include "ImageData.h"
+
+const unsigned char dayrise_splashscreen_rle[2385] = {
+	0xf0, 0xff, 0x00, 0xfc, 0xf5, 0x00, 0xf0, 0xff, 0x00, 0xfc, 0xf5, 0x00, 0xf0, 0xff, 0x00, 0xfe,
+	0xf5, 0x00, 0xf0, 0xff, 0x00, 0xfe, 0xf5, 0x00, 0xef, 0xff, 0xf5, 0x00, 0xef, 0xff, 0xf5, 0x00,
+	0xef, 0xff, 0xf5, 0x00, 0xef, 0xff, 0x00, 0x80, 0xf6, 0x00, 0xef, 0xff, 0x00, 0x80, 0xf6, 0x00,
+	0xef, 0xff, 0x00, 0xc0, 0xf6, 0x00, 0xef, 0xff, 0x00, 0xc0, 0xf6, 0x00, 0xef, 0xff, 0x00, 0xc0,
+	0xf6, 0x00, 0xef, 0xff, 0x00, 0xe0, 0xf6, 0x00, 0xef, 0xff, 0x00, 0xe0, 0xf6, 0x00, 0xef, 0xff,
+	0x00, 0xf0, 0xf6, 0x00, 0xef, 0xff, 0x00, 0xf0, 0xf6, 0x00, 0xef, 0xff, 0x00, 0xf0, 0xf6, 0x00,
+	0xef, 0xff, 0x00, 0xf8, 0xf6, 0x00, 0xef, 0xff, 0x00, 0xf8, 0xf6, 0x00, 0xef, 0xff, 0x00, 0xfc,
+	0xf6, 0x00, 0xef, 0xff, 0x00, 0xfc, 0xf6, 0x00, 0xef, 0xff, 0x00, 0xfe, 0xf6, 0x00, 0xef, 0xff,
+	0x00, 0xfe, 0xf6, 0x00, 0xee, 0xff, 0xf6, 0x00, 0xee, 0xff, 0xf6, 0x00, 0xee, 0xff, 0x00, 0x80,
+	0xf7, 0x00, 0xee, 0xff, 0x00, 0x80, 0xf7, 0x00, 0xee, 0xff, 0x00, 0xc0, 0xf7, 0x00, 0xee, 0xff,
+	0x00, 0xc0, 0xf7, 0x00, 0xee, 0xff, 0x00, 0xe0, 0xf7, 0x00, 0xee, 0xff, 0x00, 0xe0, 0xf7, 0x00,
+	0xee, 0xff, 0x00, 0xf0, 0xf7, 0x00, 0xee, 0xff, 0x00, 0xf0, 0xf7, 0x00, 0xee, 0xff, 0x00, 0xf8,
+	0xf7, 0x00, 0xee, 0xff, 0x00, 0xf8, 0xf7, 0x00, 0xee, 0xff, 0x00, 0xfc, 0xf7, 0x00, 0xee, 0xff,
+	0x00, 0xfc, 0xf7, 0x00, 0xee, 0xff, 0x00, 0xfe, 0xf7, 0x00, 0xee, 0xff, 0x00, 0xfe, 0xf7, 0x00,
+	0xed, 0xff, 0xf7, 0x00, 0xed, 0xff, 0x00, 0x80, 0xf8, 0x00, 0xed, 0xff, 0x00, 0x80, 0xf8, 0x00,
+	0xed, 0xff, 0x00, 0xc0, 0xf8, 0x00, 0xed, 0xff, 0x00, 0xc0, 0xf8, 0x00, 0xed, 0xff, 0x00, 0xe0,
+	0xf8, 0x00, 0xed, 0xff, 0x00, 0xf0, 0xf8, 0x00, 0xed, 0xff, 0x00, 0xf0, 0xf8, 0x00, 0xed, 0xff,
+	0x00, 0xf8, 0xf8, 0x00, 0xed, 0xff, 0x00, 0xf8, 0xf8, 0x00, 0xed, 0xff, 0x00, 0xfc, 0xf8, 0x00,
+	0xed, 0xff, 0x00, 0xfc, 0xf8, 0x00, 0xed, 0xff, 0x00, 0xfe, 0xf8, 0x00, 0xec, 0xff, 0xf8, 0x00,
+	0xec, 0xff, 0xf8, 0x00, 0xec, 0xff, 0x00, 0x80, 0xf9, 0x00, 0xec, 0xff, 0x00, 0xc0, 0xf9, 0x00,
+	0xec, 0xff, 0x00, 0xc0, 0xf9, 0x00, 0xec, 0xff, 0x00, 0xe0, 0xf9, 0x00, 0xec, 0xff, 0x00, 0xf0,
+	0xf9, 0x00, 0xec, 0xff, 0x00, 0xf8, 0xf9, 0x00, 0xec, 0xff, 0x00, 0xf8, 0xf9, 0x00, 0xec, 0xff,
+	0x00, 0xfc, 0xf9, 0x00, 0xec, 0xff, 0x00, 0xfe, 0xf9, 0x00, 0xec, 0xff, 0x00, 0xfe, 0xf9, 0x00,
+	0xeb, 0xff, 0xf9, 0x00, 0xeb, 0xff, 0x00, 0x80, 0xfa, 0x00, 0xeb, 0xff, 0x00, 0x80, 0xfa, 0x00,
+	0xeb, 0xff, 0x00, 0xc0, 0xfa, 0x00, 0xeb, 0xff, 0x00, 0xe0, 0xfa, 0x00, 0xeb, 0xff, 0x00, 0xf0,
+	0xfa, 0x00, 0xeb, 0xff, 0x00, 0xf8, 0xfa, 0x00, 0xeb, 0xff, 0x00, 0xfc, 0xfa, 0x00, 0xeb, 0xff,
+	0x00, 0xfc, 0xfa, 0x00, 0xeb, 0xff, 0x00, 0xfe, 0xfa, 0x00, 0xea, 0xff, 0xfa, 0x00, 0xea, 0xff,
+	0x00, 0x80, 0xfb, 0x00, 0xea, 0xff, 0x00, 0xc0, 0xfb, 0x00, 0xea, 0xff, 0x00, 0xc0, 0xfb, 0x00,
+	0xea, 0xff, 0x00, 0xe0, 0xfb, 0x00, 0xea, 0xff, 0x00, 0xf0, 0xfb, 0x00, 0xea, 0xff, 0x00, 0xf8,
+	0xfb, 0x00, 0xea, 0xff, 0x00, 0xfc, 0xfb, 0x00, 0xea, 0xff, 0x00, 0xfe, 0xfb, 0x00, 0xe9, 0xff,
+	0xfb, 0x00, 0xe9, 0xff, 0x00, 0x80, 0xfc, 0x00, 0xe9, 0xff, 0x00, 0xc0, 0xfc, 0x00, 0xe9, 0xff,
+	0x00, 0xe0, 0xfc, 0x00, 0xe9, 0xff, 0x00, 0xf0, 0xfc, 0x00, 0xe9, 0xff, 0x00, 0xf8, 0xfc, 0x00,
+	0xe9, 0xff, 0x00, 0xfc, 0xfc, 0x00, 0xe9, 0xff, 0x00, 0xfe, 0xfc, 0x00, 0xe8, 0xff, 0xfc, 0x00,
+	0xe8, 0xff, 0x00, 0x80, 0xfd, 0x00, 0xe8, 0xff, 0x00, 0xc0, 0xfd, 0x00, 0xe8, 0xff, 0x00, 0xe0,
+	0xfd, 0x00, 0xe8, 0xff, 0x00, 0xf0, 0xfd, 0x00, 0xe8, 0xff, 0x00, 0xf8, 0xfd, 0x00, 0xe8, 0xff,
+	0x00, 0xfc, 0xfd, 0x00, 0xe7, 0xff, 0xfd, 0x00, 0xe7, 0xff, 0x00, 0x80, 0xfe, 0x00, 0xe7, 0xff,
+	0x00, 0xc0, 0xfe, 0x00, 0xe7, 0xff, 0x00, 0xe0, 0xfe, 0x00, 0xe7, 0xff, 0x00, 0xf0, 0xfe, 0x00,
+	0xe7, 0xff, 0x00, 0xf8, 0xfe, 0x00, 0xe7, 0xff, 0x00, 0xfe, 0xfe, 0x00, 0xe6, 0xff, 0xfe, 0x00,
+	0xe6, 0xff, 0x00, 0xc0, 0xff, 0x00, 0xe6, 0xff, 0x00, 0xe0, 0xff, 0x00, 0xe6, 0xff, 0x00, 0xf0,
+	0xff, 0x00, 0xe6, 0xff, 0x00, 0xfc, 0xff, 0x00, 0xf4, 0xff, 0x01, 0xf1, 0xfb, 0xf5, 0xff, 0x00,
+	0xfe, 0xff, 0x00, 0xf5, 0xff, 0x03, 0xf0, 0x00, 0xf0, 0x1f, 0xf5, 0xff, 0x01, 0x80, 0x00, 0xf5,
+	0xff, 0x03, 0xc0, 0x00, 0xf0, 0x07, 0xff, 0xff, 0x01, 0xc0, 0x3f, 0xf9, 0xff, 0x01, 0xc0, 0x00,
+	0xf5, 0xff, 0x03, 0x80, 0x00, 0xf0, 0x03, 0xff, 0xff, 0x01, 0x80, 0x3f, 0xf9, 0xff, 0x01, 0xf0,
+	0x00, 0xf5, 0xff, 0xff, 0x00, 0x01, 0xf0, 0x01, 0xff, 0xff, 0x00, 0xbf, 0xf8, 0xff, 0x01, 0xfc,
+	0x00, 0xf5, 0xff, 0xff, 0x00, 0x01, 0xf0, 0x01, 0xf4, 0xff, 0x00, 0x00, 0xf5, 0xff, 0x03, 0x03,
+	0xf8, 0xff, 0x81, 0xff, 0xff, 0x01, 0x80, 0x3f, 0xf8, 0xff, 0x00, 0x80, 0xf5, 0xff, 0x03, 0x0f,
+	0xf8, 0xff, 0xe0, 0xff, 0xff, 0x01, 0x80, 0x3f, 0xf8, 0xff, 0x00, 0xe0, 0xf6, 0xff, 0x04, 0xfe,
+	0x0f, 0xf8, 0xff, 0xe0, 0xf4, 0xff, 0x00, 0xf8, 0xf6, 0xff, 0x08, 0xfe, 0x0f, 0xf8, 0xff, 0xf0,
+	0xff, 0xfd, 0x80, 0x3f, 0xf8, 0xff, 0x00, 0xfe, 0xf6, 0xff, 0x08, 0xfe, 0x0f, 0xf8, 0xff, 0xe0,
+	0xff, 0xfc, 0x80, 0x3f, 0xeb, 0xff, 0x03, 0x0f, 0xf8, 0xff, 0xe0, 0xe7, 0xff, 0x03, 0x03, 0xf8,
+	0xff, 0x80, 0xe7, 0xff, 0xfe, 0x00, 0x00, 0x01, 0xff, 0xff, 0x01, 0xc0, 0x3f, 0xeb, 0xff, 0x00,
+	0x80, 0xff, 0x00, 0x00, 0x01, 0xff, 0xff, 0x01, 0x93, 0x7f, 0xeb, 0xff, 0x00, 0x80, 0xff, 0x00,
+	0x00, 0x03, 0xff, 0xff, 0x01, 0xbb, 0xbf, 0xeb, 0xff, 0x00, 0xc0, 0xff, 0x00, 0x00, 0x07, 0xff,
+	0xff, 0x01, 0x88, 0x3f, 0xeb, 0xff, 0x00, 0xf0, 0xff, 0x00, 0x00, 0x1f, 0xff, 0xff, 0x01, 0xec,
+	0x7f, 0xea, 0xff, 0x01, 0xc0, 0x07, 0xe0, 0xff, 0x01, 0xbf, 0x8f, 0xe5, 0xff, 0x01, 0xc1, 0xaf,
+	0xe5, 0xff, 0x01, 0xbd, 0x27, 0xe5, 0xff, 0x01, 0xbd, 0x27, 0xeb, 0xff, 0x03, 0xfe, 0xff, 0xf0,
+	0x0f, 0xff, 0xff, 0x01, 0x80, 0x07, 0xeb, 0xff, 0x03, 0xf0, 0xff, 0xc0, 0x07, 0xff, 0xff, 0x01,
+	0xe7, 0xcf, 0xeb, 0xff, 0x03, 0xc0, 0x7f, 0x80, 0x03, 0xe7, 0xff, 0x03, 0x80, 0x7f, 0x00, 0x01,
+	0xff, 0xff, 0x01, 0xc0, 0x3f, 0xeb, 0xff, 0x03, 0x00, 0xfe, 0x00, 0x01, 0xff, 0xff, 0x01, 0x80,
+	0x7f, 0xeb, 0xff, 0x03, 0x07, 0xfc, 0x07, 0xe0, 0xff, 0xff, 0x01, 0xbb, 0xbf, 0xeb, 0xff, 0x03,
+	0x0f, 0xf8, 0x0f, 0xe0, 0xff, 0xff, 0x01, 0x98, 0x3f, 0xeb, 0xff, 0x03, 0x0f, 0xf0, 0x1f, 0xf0,
+	0xff, 0xff, 0x01, 0xcc, 0x3f, 0xec, 0xff, 0x04, 0xfe, 0x0f, 0xe0, 0x3f, 0xe0, 0xe8, 0xff, 0x04,
+	0xfe, 0x0f, 0xc0, 0x3f, 0xe0, 0xe7, 0xff, 0x03, 0x07, 0x80, 0x7f, 0xc0, 0xe7, 0xff, 0xff, 0x00,
+	0x01, 0xff, 0x81, 0xe7, 0xff, 0x03, 0x00, 0x01, 0xfc, 0x01, 0xe7, 0xff, 0x03, 0x80, 0x03, 0xfc,
+	0x03, 0xff, 0xff, 0x01, 0xc2, 0x7f, 0xeb, 0xff, 0x03, 0xc0, 0x07, 0xfc, 0x07, 0xff, 0xff, 0x01,
+	0x82, 0x3f, 0xeb, 0xff, 0x03, 0xe0, 0x1f, 0xfe, 0x0f, 0xff, 0xff, 0x01, 0xbb, 0xbf, 0xe9, 0xff,
+	0x01, 0xfe, 0x3f, 0xff, 0xff, 0x01, 0x93, 0x3f, 0xe5, 0xff, 0x01, 0xc0, 0x7f, 0xc7, 0xff, 0xff,
+	0xbf, 0xe5, 0xff, 0x01, 0xbf, 0x3f, 0xe6, 0xff, 0x02, 0xfc, 0x00, 0x3f, 0xed, 0xff, 0x01, 0xf8,
+	0x1f, 0xfd, 0x00, 0xff, 0xff, 0x00, 0xbf, 0xec, 0xff, 0x01, 0xf8, 0x1f, 0xfd, 0x00, 0xe9, 0xff,
+	0x01, 0xf8, 0x1f, 0xfd, 0x00, 0xff, 0xff, 0x01, 0xe0, 0x3f, 0xed, 0xff, 0x01, 0xf8, 0x1f, 0xfd,
+	0x00, 0xff, 0xff, 0x01, 0x80, 0x3f, 0xed, 0xff, 0x01, 0xf8, 0x1f, 0xfd, 0x00, 0xff, 0xff, 0x01,
+	0xbb, 0x3f, 0xed, 0xff, 0x01, 0xf8, 0x1f, 0xfe, 0x00, 0x00, 0x01, 0xff, 0xff, 0x01, 0x99, 0x3f,
+	0xe5, 0xff, 0x01, 0xcc, 0x3f, 0xaa, 0xff, 0x02, 0xf8, 0x00, 0x3f, 0xec, 0xff, 0x01, 0xfe, 0x03,
+	0xfd, 0xff, 0x02, 0xfc, 0x00, 0x3f, 0xeb, 0xff, 0x00, 0x07, 0xe4, 0xff, 0x00, 0x07, 0xe4, 0xff,
+	0x00, 0x07, 0xe4, 0xff, 0x00, 0x83, 0xe4, 0xff, 0x00, 0x83, 0xe4, 0xff, 0x00, 0xe1, 0xfc, 0xff,
+	0x01, 0xc0, 0x7f, 0xeb, 0xff, 0x00, 0xf0, 0xfc, 0xff, 0x01, 0x80, 0x3f, 0xeb, 0xff, 0xfd, 0x00,
+	0xff, 0xff, 0xff, 0xbf, 0xeb, 0xff, 0xfd, 0x00, 0xff, 0xff, 0x01, 0x9f, 0x3f, 0xeb, 0xff, 0xfd,
+	0x00, 0xff, 0xff, 0x01, 0x80, 0x07, 0xeb, 0xff, 0xfd, 0x00, 0xe7, 0xff, 0xfd, 0x00, 0xe7, 0xff,
+	0xfe, 0x00, 0x00, 0x01, 0xff, 0xff, 0x01, 0x80, 0x3f, 0xe5, 0xff, 0x01, 0x80, 0x3f, 0xe4, 0xff,
+	0x00, 0xbf, 0xe5, 0xff, 0x01, 0x80, 0x3f, 0xe5, 0xff, 0x01, 0x80, 0x3f, 0xeb, 0xff, 0x00, 0x07,
+	0xe4, 0xff, 0x01, 0x00, 0x7f, 0xe5, 0xff, 0x01, 0x00, 0x03, 0xe5, 0xff, 0xff, 0x00, 0x00, 0x3f,
+	0xe6, 0xff, 0xff, 0x00, 0x00, 0x01, 0xe6, 0xff, 0x00, 0x80, 0xff, 0x00, 0x00, 0x1f, 0xff, 0xff,
+	0x01, 0xc6, 0x7f, 0xeb, 0xff, 0x00, 0xfe, 0xff, 0x00, 0x00, 0x01, 0xff, 0xff, 0x01, 0x82, 0x3f,
+	0xea, 0xff, 0x00, 0xf8, 0xff, 0x00, 0x03, 0x1f, 0xff, 0xbb, 0xbf, 0xe9, 0xff, 0x05, 0xc0, 0x00,
+	0x07, 0xff, 0x93, 0x3f, 0xe9, 0xff, 0x05, 0xfc, 0x00, 0x03, 0xff, 0xc0, 0x7f, 0xe9, 0xff, 0x02,
+	0x80, 0x00, 0x03, 0xe7, 0xff, 0x00, 0xf0, 0xff, 0x00, 0x01, 0x01, 0xff, 0xff, 0xbf, 0xeb, 0xff,
+	0x00, 0xfc, 0xff, 0x00, 0x04, 0x03, 0xc1, 0xff, 0x8c, 0x3f, 0xeb, 0xff, 0x00, 0x80, 0xff, 0x00,
+	0x03, 0x3f, 0xc1, 0xff, 0xc0, 0xea, 0xff, 0xff, 0x00, 0x04, 0x07, 0xff, 0xe1, 0xff, 0xf3, 0xea,
+	0xff, 0xff, 0x00, 0x05, 0x7f, 0xff, 0xe1, 0xf8, 0x00, 0x3f, 0xeb, 0xff, 0x01, 0x00, 0x07, 0xff,
+	0xff, 0x03, 0xe1, 0xfc, 0x00, 0x3f, 0xeb, 0xff, 0x01, 0x00, 0x7f, 0xff, 0xff, 0x00, 0xe1, 0xe8,
+	0xff, 0x00, 0x0f, 0xfc, 0xff, 0x01, 0xe0, 0x3f, 0xe5, 0xff, 0x01, 0x80, 0x3f, 0xe5, 0xff, 0x01,
+	0xbb, 0x3f, 0xe5, 0xff, 0x01, 0x99, 0x3f, 0xe8, 0xff, 0x00, 0xfd, 0xff, 0xff, 0x01, 0xcc, 0x3f,
+	0xeb, 0xff, 0x00, 0xf8, 0xfe, 0x00, 0xe7, 0xff, 0x00, 0xe0, 0xfe, 0x00, 0xe7, 0xff, 0x00, 0xc0,
+	0xfe, 0x00, 0xff, 0xff, 0x00, 0x81, 0xea, 0xff, 0x00, 0x80, 0xfe, 0x00, 0xff, 0xff, 0x01, 0xf8,
+	0x3f, 0xeb, 0xff, 0xfe, 0x00, 0x00, 0x01, 0xff, 0xff, 0x01, 0xf0, 0x3f, 0xeb, 0xff, 0xfe, 0x00,
+	0x00, 0x0f, 0xff, 0xff, 0x00, 0x87, 0xea, 0xff, 0x03, 0x07, 0xf0, 0xff, 0x8f, 0xff, 0xff, 0x00,
+	0xc0, 0xea, 0xff, 0x03, 0x0f, 0xf0, 0xff, 0xc3, 0xff, 0xff, 0x01, 0xfc, 0x3f, 0xec, 0xff, 0x04,
+	0xfe, 0x0f, 0xf8, 0x7f, 0xe1, 0xff, 0xff, 0x01, 0x80, 0x7f, 0xeb, 0xff, 0x03, 0x0f, 0xf8, 0x3f,
+	0xe1, 0xff, 0xff, 0x00, 0x9f, 0xea, 0xff, 0x03, 0x0f, 0xfc, 0x1f, 0xe0, 0xe7, 0xff, 0x03, 0x07,
+	0xfc, 0x0f, 0xc0, 0xe7, 0xff, 0x01, 0x00, 0x3e, 0xff, 0x00, 0xe7, 0xff, 0x01, 0x00, 0x3f, 0xff,
+	0x00, 0xe7, 0xff, 0x03, 0x80, 0x3f, 0x00, 0x01, 0xff, 0xff, 0x00, 0x9f, 0xea, 0xff, 0x03, 0xc0,
+	0x3f, 0x80, 0x01, 0xff, 0xff, 0x00, 0xdf, 0xea, 0xff, 0x03, 0xe0, 0x3f, 0xe0, 0x07, 0xff, 0xff,
+	0x01, 0x80, 0x3f, 0xeb, 0xff, 0x03, 0xf8, 0x3f, 0xf0, 0x0f, 0xff, 0xff, 0x01, 0x80, 0x3f, 0xc7,
+	0xff, 0x00, 0xe6, 0xe4, 0xff, 0x01, 0x82, 0x3f, 0xe5, 0xff, 0x01, 0xbb, 0xbf, 0xe5, 0xff, 0x01,
+	0xbb, 0xbf, 0xe5, 0xff, 0x01, 0x80, 0x3f, 0xed, 0xff, 0x00, 0xe0, 0xfc, 0x00, 0xff, 0xff, 0x00,
+	0xf1, 0xec, 0xff, 0x00, 0xe0, 0xfc, 0x00, 0xe9, 0xff, 0x00, 0xe0, 0xfc, 0x00, 0xff, 0xff, 0x00,
+	0x81, 0xec, 0xff, 0x00, 0xe0, 0xfc, 0x00, 0xff, 0xff, 0x01, 0xf0, 0x3f, 0xed, 0xff, 0x00, 0xe0,
+	0xfc, 0x00, 0xff, 0xff, 0x01, 0xfc, 0x3f, 0xeb, 0xff, 0x00, 0x83, 0xff, 0xff, 0x00, 0xc3, 0xff,
+	0xff, 0x00, 0x80, 0xea, 0xff, 0x00, 0x87, 0xff, 0xff, 0x00, 0xe3, 0xff, 0xff, 0x00, 0x9f, 0xea,
+	0xff, 0x00, 0x0f, 0xff, 0xff, 0x00, 0xe1, 0xe7, 0xff, 0x00, 0x0f, 0xff, 0xff, 0x00, 0xe1, 0xff,
+	0xff, 0x01, 0xc2, 0x7f, 0xeb, 0xff, 0x00, 0x0f, 0xff, 0xff, 0x00, 0xe0, 0xff, 0xff, 0x01, 0x93,
+	0x3f, 0xec, 0xff, 0x01, 0xfe, 0x0f, 0xff, 0xff, 0x00, 0xe0, 0xff, 0xff, 0x01, 0xbb, 0xbf, 0xeb,
+	0xff, 0x00, 0x07, 0xff, 0xff, 0x00, 0xc0, 0xff, 0xff, 0x01, 0x80, 0x3f, 0xeb, 0xff, 0x03, 0x00,
+	0x3f, 0xf8, 0x00, 0xff, 0xff, 0x01, 0xc0, 0x7f, 0xeb, 0xff, 0xfe, 0x00, 0x00, 0x01, 0xe7, 0xff,
+	0x00, 0x80, 0xff, 0x00, 0x00, 0x01, 0xff, 0xff, 0x01, 0xc0, 0x3f, 0xeb, 0xff, 0x00, 0x80, 0xff,
+	0x00, 0x00, 0x03, 0xff, 0xff, 0x01, 0x80, 0x3f, 0xeb, 0xff, 0x00, 0xe0, 0xff, 0x00, 0x00, 0x07,
+	0xff, 0xff, 0x00, 0xbf, 0xea, 0xff, 0x00, 0xf8, 0xff, 0x00, 0x00, 0x3f, 0xe1, 0xff, 0x01, 0x80,
+	0x3f, 0xe5, 0xff, 0x01, 0x80, 0x3f, 0x81, 0xff, 0x81, 0xff, 0x81, 0xff, 0x81, 0xff, 0x81, 0xff,
+	0xc5, 0xff, 0x00, 0x1f, 0xe4, 0xff, 0x00, 0x03, 0xe4, 0xff, 0x01, 0x00, 0x7f, 0xe5, 0xff, 0x01,
+	0x00, 0x0f, 0xe5, 0xff, 0x01, 0x00, 0x03, 0xe5, 0xff, 0xff, 0x00, 0x00, 0x7f, 0xe6, 0xff, 0xff,
+	0x00, 0x00, 0x1f, 0xe6, 0xff, 0xff, 0x00, 0x00, 0x07, 0xe6, 0xff, 0xff, 0x00, 0x00, 0x01, 0xe6,
+	0xff, 0xfe, 0x00, 0x00, 0x7f, 0xe7, 0xff, 0xfe, 0x00, 0x00, 0x1f, 0xe7, 0xff, 0xfe, 0x00, 0x00,
+	0x0f, 0xe7, 0xff, 0xfe, 0x00, 0x00, 0x03, 0xe7, 0xff, 0xfe, 0x00, 0x00, 0x01, 0xe7, 0xff, 0xfd,
+	0x00, 0x00, 0x7f, 0xe8, 0xff, 0xfd, 0x00, 0x00, 0x1f, 0xe8, 0xff, 0xfd, 0x00, 0x00, 0x0f, 0xe8,
+	0xff, 0xfd, 0x00, 0x00, 0x07, 0xe8, 0xff, 0xfd, 0x00, 0x00, 0x01, 0xe8, 0xff, 0xfc, 0x00, 0xe8,
+	0xff, 0xfc, 0x00, 0x00, 0x7f, 0xe9, 0xff, 0xfc, 0x00, 0x00, 0x1f, 0xe9, 0xff, 0xfc, 0x00, 0x00,
+	0x0f, 0xe9, 0xff, 0xfc, 0x00, 0x00, 0x07, 0xe9, 0xff, 0xfc, 0x00, 0x00, 0x03, 0xe9, 0xff, 0xfc,
+	0x00, 0x00, 0x01, 0xe9, 0xff, 0xfb, 0x00, 0xe9, 0xff, 0xfb, 0x00, 0x00, 0x7f, 0xea, 0xff, 0xfb,
+	0x00, 0x00, 0x3f, 0xea, 0xff, 0xfb, 0x00, 0x00, 0x0f, 0xea, 0xff, 0xfb, 0x00, 0x00, 0x0f, 0xea,
+	0xff, 0xfb, 0x00, 0x00, 0x07, 0xea, 0xff, 0xfb, 0x00, 0x00, 0x03, 0xea, 0xff, 0xfb, 0x00, 0x00,
+	0x01, 0xea, 0xff, 0xfa, 0x00, 0xea, 0xff, 0xfa, 0x00, 0x00, 0x7f, 0xeb, 0xff, 0xfa, 0x00, 0x00,
+	0x3f, 0xeb, 0xff, 0xfa, 0x00, 0x00, 0x1f, 0xeb, 0xff, 0xfa, 0x00, 0x00, 0x0f, 0xeb, 0xff, 0xfa,
+	0x00, 0x00, 0x0f, 0xeb, 0xff, 0xfa, 0x00, 0x00, 0x07, 0xeb, 0xff, 0xfa, 0x00, 0x00, 0x03, 0xeb,
+	0xff, 0xfa, 0x00, 0x00, 0x03, 0xeb, 0xff, 0xfa, 0x00, 0x00, 0x01, 0xeb, 0xff, 0xf9, 0x00, 0xeb,
+	0xff, 0xf9, 0x00, 0x00, 0x7f, 0xec, 0xff, 0xf9, 0x00, 0x00, 0x7f, 0xec, 0xff, 0xf9, 0x00, 0x00,
+	0x3f, 0xec, 0xff, 0xf9, 0x00, 0x00, 0x1f, 0xec, 0xff, 0xf9, 0x00, 0x00, 0x1f, 0xec, 0xff, 0xf9,
+	0x00, 0x00, 0x0f, 0xec, 0xff, 0xf9, 0x00, 0x00, 0x0f, 0xec, 0xff, 0xf9, 0x00, 0x00, 0x07, 0xec,
+	0xff, 0xf9, 0x00, 0x00, 0x03, 0xec, 0xff, 0xf9, 0x00, 0x00, 0x03, 0xec, 0xff, 0xf9, 0x00, 0x00,
+	0x01, 0xec, 0xff, 0xf9, 0x00, 0x00, 0x01, 0xec, 0xff, 0xf8, 0x00, 0xec, 0xff, 0xf8, 0x00, 0xec,
+	0xff, 0xf8, 0x00, 0x00, 0x7f, 0xed, 0xff, 0xf8, 0x00, 0x00, 0x7f, 0xed, 0xff, 0xf8, 0x00, 0x00,
+	0x3f, 0xed, 0xff, 0xf8, 0x00, 0x00, 0x3f, 0xed, 0xff, 0xf8, 0x00, 0x00, 0x3f, 0xed, 0xff, 0xf8,
+	0x00, 0x00, 0x1f, 0xed, 0xff, 0xf8, 0x00, 0x00, 0x1f, 0xed, 0xff, 0xf8, 0x00, 0x00, 0x0f, 0xed,
+	0xff, 0xf8, 0x00, 0x00, 0x0f, 0xed, 0xff, 0xf8, 0x00, 0x00, 0x0f, 0xed, 0xff, 0xf8, 0x00, 0x00,
+	0x07, 0xed, 0xff, 0xf8, 0x00, 0x00, 0x07, 0xed, 0xff, 0xf8, 0x00, 0x00, 0x07, 0xed, 0xff, 0xf8,
+	0x00, 0x00, 0x03, 0xed, 0xff, 0xf8, 0x00, 0x00, 0x03, 0xed, 0xff, 0xf8, 0x00, 0x00, 0x01, 0xed,
+	0xff, 0xf8, 0x00, 0x00, 0x01, 0xed, 0xff, 0xf8, 0x00, 0x00, 0x01, 0xed, 0xff, 0xf8, 0x00, 0x00,
+	0x01, 0xed, 0xff, 0xf7, 0x00, 0xed, 0xff, 0xf7, 0x00, 0xed, 0xff, 0xf7, 0x00, 0xed, 0xff, 0xf7,
+	0x00, 0xed, 0xff, 0xf7, 0x00, 0x00, 0x7f, 0xee, 0xff, 0xf7, 0x00, 0x00, 0x7f, 0xee, 0xff, 0xf7,
+	0x00, 0x00, 0x7f, 0xee, 0xff, 0xf7, 0x00, 0x00, 0x7f, 0xee, 0xff, 0xf7, 0x00, 0x00, 0x7f, 0xee,
+	0xff,
+};
@@ -1,22 +1,82 @@
 #include "DEV_Config.h"
 #include "EPD.h"
 #include "GUI_Paint.h"
+#include "GUI_Cache.h"
+#include "GUI_Format.h"
+#include "Screens.h"
+#include "Link.h"
+#include "Power.h"
+#include "DayriseLog.h"
 #include "images/imagedata.h"
 #include <stdlib.h>
-#include <HardwareSerial.h>
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include <esp_timer.h>
 #include "TickTwo.h"
 
-// UART2 für serielle Kommunikation (dieser Code ist für den Slave)
-HardwareSerial SerialPort(2); 
-
-// Der Schwarz-Weiß-Bildspeicher
+// Der Schwarz-Weiß-Bildspeicher. Er gehört dem Render-Task und enthält immer den ganzen
+// Bildschirm, die Bildschirme des Weckers und die Ausschnitte des Masters werden hineingezeichnet
 UBYTE *BlackImage;
 
-// Die Daten, die vom Master gesendet werden
-String msg;
-String controlBit;
-String secondParam;
-String thirdParam;
+// Render-Pipeline: Core 1 zeichnet die Bilder, Core 0 überträgt sie und refresht das Display.
+// Die Bildspeicher wandern über zwei Queues zwischen den beiden Tasks hin und her.
+#define FRAME_BUFFERS       2
+#define RENDER_CORE         1
+#define DRIVER_CORE         0
+#define RENDER_POLL_MS      10      // So oft schaut der Render-Task nach einem freien Bildspeicher, wenn ein Bild wartet
+#define STATS_INTERVAL_MS   10000
+#define SPLASH_MS           2000    // So lange bleibt der Splashscreen stehen, wenn kein Bild kommt
+
+// Ein fertiges Bild und der Ausschnitt, der sich seit dem letzten Bild geändert hat.
+// Koordinaten des Bildspeichers (ohne Rotation), x und w sind Vielfache von 8.
+typedef struct {
+    UBYTE *frame;
+    UWORD x;
+    UWORD y;
+    UWORD w;
+    UWORD h;
+} FrameJob;
+
+UBYTE *FrameBuffers[FRAME_BUFFERS];
+QueueHandle_t freeFrames;   // Leere Bildspeicher für den Render-Task
+QueueHandle_t fullFrames;   // Fertige Bilder (FrameJob) für den Driver-Task
+
+// Laufzeitstatistik einer Pipeline-Stufe
+typedef struct {
+    volatile uint32_t busyUs;   // Zeit, in der die Stufe gearbeitet hat (ohne Warten auf die Queues)
+    volatile uint32_t frames;
+} StageStats;
+
+StageStats renderStats;
+StageStats driverStats;
+
+// Zeiten des letzten Bildes und übertragene Bytes, für die Telemetrie an den Master
+volatile uint32_t lastRenderUs;
+volatile uint32_t lastTransferUs;
+volatile uint32_t lastRefreshUs;
+volatile uint32_t transferBytes;
+
+// Solange der Driver-Task das Display startet, bleibt der ESP32 wach (siehe sleepIfIdle())
+volatile bool booting = true;
+// Zeit vom Reset bis das erste Bild auf dem Display steht
+volatile uint32_t firstFrameMs;
+
+// Cache für die vorgerenderten Zeichen, hängt am Standard-Kontext Paint
+GLYPH_CACHE GlyphCache;
+
+// Nachrichten des Masters, gefüllt vom Link-Task (siehe Link.cpp)
+QueueHandle_t messages;
+
+// Nachrichten, die nichts am Bild geändert haben und deshalb nicht gezeichnet wurden
+volatile uint32_t skippedFrames;
+// Nachrichten, die von einer neueren überholt wurden, bevor sie gezeichnet werden konnten
+volatile uint32_t coalescedMessages;
+// Ausschnitte des Masters (PROTOCOL_MSG_REGION): gezeichnet, verworfen und die Bytes ihrer Frames
+volatile uint32_t regionMessages;
+volatile uint32_t rejectedRegions;
+volatile uint32_t regionBytes;
 
 /**
  * @brief Vollständiges Refreshen des Displays.
@@ -42,50 +102,39 @@ void quickRefresh() {
 }
 
 /**
- * @brief Zentriert den Text horizontal.
- * 
- * @param fontSize in Pixel
- * @return int y-Position in Pixel
+ * @brief Zeigt den Splashscreen an.
+ * Das komprimierte Bild wird direkt beim Senden an das Display entpackt,
+ * dafür wird kein Bildspeicher gebraucht.
+ * Läuft im Driver-Task, der Render-Task kann währenddessen schon zeichnen. Sobald
+ * das erste Bild fertig ist, wird der Splashscreen abgebrochen.
+ *
+ * @param job Das erste Bild, wenn es den Splashscreen abgebrochen hat
+ * @return true, wenn der Splashscreen abgebrochen wurde und job gesetzt ist
  */
-int getHorizontalCenter(int fontSize) {
-    return (EPD_3IN52_WIDTH/2)-(fontSize/2);
-}
-
-/**
- * @brief Get the Vertical Center object
- * 
- * @param fontHeight Die Höhe des Fonts (siehe in /fonts Ordner, dort ist diese Konfiguriert)
- * @param letters Anzahl der Biuchstaben
- * @return int 
- */
-int getVerticalCenter(int fontHeight, int letters) {
-    return (EPD_3IN52_WIDTH/2)-((fontHeight*letters)/2);
-}
-
-void displaySplashScreen() {
-    Paint_NewImage(BlackImage, EPD_3IN52_WIDTH, EPD_3IN52_HEIGHT, 270, WHITE);
-    Paint_Clear(WHITE);
-    Paint_DrawBitMap(dayrise_splashscreen);
-    EPD_3IN52_display(BlackImage);
+bool displaySplashScreen(FrameJob *job) {
+    EPD_3IN52_display_RLE(dayrise_splashscreen_rle);
     fullRefresh();
-    delay(2000);
+    if (xQueueReceive(fullFrames, job, pdMS_TO_TICKS(SPLASH_MS)) == pdTRUE) {
+        return true;
+    }
     fullRefresh();
+    return false;
 }
 
 /**
- * @brief Zeigt Indikator und verbleibende Zeit auf Display an, ob ein Alarm aktiv ist oder nicht.
- * Der Indikator ist ein ausgefüllter Kreis (aktiv) oder nur die Kontur eines Kreises (nicht aktiv).
- * 
- * @param isActive true = Alarm aktiv, false = Alarm nicht aktiv
+ * @brief Startet das Display und zeigt den Splashscreen an.
+ *
+ * @param job Das erste Bild, wenn es den Splashscreen abgebrochen hat
+ * @return true, wenn job gesetzt ist
  */
-void setActiveAlarm(boolean isActive, String timeRemaining) {
-    if(isActive) {
-        Paint_DrawCircle(35, 22, 4, BLACK, DOT_PIXEL_1X1, DRAW_FILL_FULL);
-        Paint_DrawString_EN(48, 14, timeRemaining.c_str(), &FontRoboto13, WHITE, BLACK);
-    } else {
-        Paint_DrawCircle(35, 22, 4, BLACK, DOT_PIXEL_1X1, DRAW_FILL_EMPTY);
-        Paint_DrawString_EN(48, 14, "No alarm", &FontRoboto13, WHITE, BLACK);
-    }
+bool bootDisplay(FrameJob *job) {
+    EPD_3IN52_Init();
+    fullRefresh();
+
+    EPD_3IN52_SendCommand(0x50);    // KEINE Ahnung was die Hexadezimalzahlen für Befehle sein sollen, aber ist wichtig
+    EPD_3IN52_SendData(0x17);       // KEINE Ahnung was die Hexadezimalzahlen für Befehle sein sollen, aber ist wichtig
+
+    return displaySplashScreen(job);
 }
 
 /**
@@ -94,149 +143,493 @@ void setActiveAlarm(boolean isActive, String timeRemaining) {
  * Die Stromversorgung wird auf 0 gesetzt.
  */
 void setDisplayToSleep() {
-    printf("Clearen des Displays\r\n");
+    LOG_INFO("Clearen des Displays");
     EPD_3IN52_Clear();
     
-    printf("Goto Sleep...\r\n");
+    LOG_INFO("Goto Sleep...");
     EPD_3IN52_sleep();
 
     free(BlackImage);
     BlackImage = NULL;
     DEV_Delay_ms(2000); 
 
-    printf("5V wird geschlossen und Stromversorgung auf 0 gesetzt\r\n");
+    LOG_INFO("5V wird geschlossen und Stromversorgung auf 0 gesetzt");
+}
+
+/**
+ * @brief Bestimmt den Zustand des Displays, den eine Nachricht des Masters verlangt.
+ * Jede Nachricht beschreibt den ganzen Bildschirm, der vorherige Zustand spielt keine Rolle.
+ *
+ * PROTOCOL_MSG_TIME  = Aktuelle Uhrzeit und verbleibende Zeit bis zum Alarm (früher "0|hh:mm|hh:mm")
+ * PROTOCOL_MSG_ALARM = Weckzeit einstellen (früher "1|hh:mm|0" bzw. "1|hh:mm|1")
+ *
+ * @param message Die empfangene Nachricht
+ * @param state Der neue Zustand
+ * @return true, wenn die Nachricht einen Bildschirm beschreibt
+ */
+bool stateFromMessage(const LinkMessage *message, ScreenState *state) {
+    memset(state, 0, sizeof(ScreenState));
+    if (message->Type == PROTOCOL_MSG_TIME) {
+        state->mode = SCREEN_TIME;
+        state->hour = message->Time.Hour;
+        state->min = message->Time.Min;
+        if (message->Time.HasRemaining) {
+            state->hasRemaining = 1;
+            state->remainingHour = message->Time.RemainingHour;
+            state->remainingMin = message->Time.RemainingMin;
+        }
+        return true;
+    }
+    if (message->Type == PROTOCOL_MSG_ALARM) {
+        // Der Alarmstatus ändert nichts am Bild, siehe Screen_Alarm()
+        state->mode = SCREEN_ALARM;
+        state->hour = message->Alarm.Hour;
+        state->min = message->Alarm.Min;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Was der Render-Task zwischen zwei Bildern weiß. BlackImage zeigt immer shown
+ * bzw. die Ausschnitte des Masters, ein neuer Zustand (next) wird erst gezeichnet, wenn
+ * er gebraucht wird. So zählt bei mehreren Nachrichten hintereinander nur die neueste.
+ */
+typedef struct {
+    ScreenState shown;      // In BlackImage gezeichnet
+    ScreenState next;       // Noch nicht gezeichnet, nur gültig mit nextPending
+    bool nextPending;
+    bool ready;             // Ein Bild wartet auf einen freien Bildspeicher
+    UWORD dirtyX0, dirtyY0, dirtyX1, dirtyY1;  // Geänderter Bereich seit dem letzten Bild, leer mit dirtyX1 == 0
+    uint32_t linkBytes;     // Bytes der Ausschnitte seit dem letzten Bild
+} RenderState;
+
+/**
+ * @brief Erweitert den geänderten Bereich um einen Ausschnitt des Bildspeichers.
+ */
+void markDirty(RenderState *render, UWORD x, UWORD y, UWORD w, UWORD h) {
+    if (render->dirtyX1 == 0) {
+        render->dirtyX0 = x;
+        render->dirtyY0 = y;
+        render->dirtyX1 = x + w;
+        render->dirtyY1 = y + h;
+        return;
+    }
+    render->dirtyX0 = x < render->dirtyX0 ? x : render->dirtyX0;
+    render->dirtyY0 = y < render->dirtyY0 ? y : render->dirtyY0;
+    render->dirtyX1 = x + w > render->dirtyX1 ? x + w : render->dirtyX1;
+    render->dirtyY1 = y + h > render->dirtyY1 ? y + h : render->dirtyY1;
 }
 
 /**
- * @brief Gitb den Parameter an der angegebenen Stelle zurück von den 
- * Daten die mit "|" getrennt sind.
- * 
- * @param data Der gesendete String 
- * @param index An welcher Stelle nach dem | soll der Parameter zurückgegeben werden
- * @return String 
+ * @brief Zeichnet den neuen Zustand in BlackImage. Er beschreibt den ganzen Bildschirm.
  */
-String getParam(String data, int index)
-{
-    char separator = '|';
-    int found = 0;
-    int strIndex[] = { 0, -1 };
-    int maxIndex = data.length() - 1;
+void drawNextState(RenderState *render) {
+    uint32_t start = micros();
+    Paint_Clear(WHITE);
+    Screen_Draw(&Paint, &render->next);
+    render->shown = render->next;
+    render->nextPending = false;
+    markDirty(render, 0, 0, EPD_3IN52_WIDTH, EPD_3IN52_HEIGHT);
+
+    lastRenderUs = micros() - start;
+    renderStats.busyUs += lastRenderUs;
+}
+
+/**
+ * @brief Übernimmt eine Nachricht des Masters.
+ *
+ * PROTOCOL_MSG_TIME und PROTOCOL_MSG_ALARM (siehe stateFromMessage()) werden erst gezeichnet, wenn das Bild gebraucht wird, und nur, wenn sich der Zustand ändert.
+ *
+ * PROTOCOL_MSG_REGION = Ausschnitt des Bildspeichers, wird sofort in BlackImage entpackt.
+ * Ein noch nicht gezeichneter Zustand liegt darunter und wird vorher gezeichnet. Erst der
+ * Ausschnitt mit PROTOCOL_REGION_REFRESH bringt das Bild auf das Display.
+ *
+ * @param render Zustand des Render-Tasks
+ * @param message Die empfangene Nachricht
+ * @return true, wenn danach ein neues Bild auf das Display muss
+ */
+bool applyMessage(RenderState *render, const LinkMessage *message) {
+    if (message->Type == PROTOCOL_MSG_REGION) {
+        const LinkRegion *region = &message->Region;
+        if (render->nextPending) {
+            drawNextState(render);
+        }
+        uint32_t start = micros();
+        regionBytes += PROTOCOL_FRAME_SIZE(PROTOCOL_REGION_SIZE + region->Len);
+        render->linkBytes += PROTOCOL_FRAME_SIZE(PROTOCOL_REGION_SIZE + region->Len);
+        if (!PaintCtx_DrawRegion_RLE(&Paint, region->Header.X, region->Header.Y, region->Header.W, region->Header.H,
+                                     region->Data, region->Len)) {
+            rejectedRegions++;
+            LOG_WARN("Ausschnitt %u,%u %ux%u verworfen", region->Header.X, region->Header.Y,
+                     region->Header.W, region->Header.H);
+            return false;
+        }
+        regionMessages++;
+        markDirty(render, region->Header.X, region->Header.Y, region->Header.W, region->Header.H);
+        // Der nächste Zustand wird auf jeden Fall gezeichnet, auch wenn er dem vorherigen gleicht
+        memset(&render->shown, 0, sizeof(ScreenState));
+        render->shown.mode = SCREEN_REMOTE;
+        renderStats.busyUs += micros() - start;
+        return (region->Header.Flags & PROTOCOL_REGION_REFRESH) != 0;
+    }
 
-    for (int i = 0; i <= maxIndex && found <= index; i++) {
-        if (data.charAt(i) == separator || i == maxIndex) {
-            found++;
-            strIndex[0] = strIndex[1] + 1;
-            strIndex[1] = (i == maxIndex) ? i+1 : i;
+    ScreenState state;
+    if (!stateFromMessage(message, &state)) {
+        return false;
+    }
+    const ScreenState *current = render->nextPending ? &render->next : &render->shown;
+    if (memcmp(&state, current, sizeof(ScreenState)) == 0) {
+        skippedFrames++;
+        return false;
+    }
+    if (render->nextPending) {
+        coalescedMessages++;
+        // Zurück zum gezeigten Zustand (z.B. A -> B -> A am Encoder): nichts mehr zu zeichnen
+        if (memcmp(&state, &render->shown, sizeof(ScreenState)) == 0) {
+            render->nextPending = false;
+            return false;
         }
     }
-    return found > index ? data.substring(strIndex[0], strIndex[1]) : "";
+    render->next = state;
+    render->nextPending = true;
+    return true;
 }
 
 /**
- * @brief Zeigt die aktuelle Uhrzeit auf dem Display an.
- * 
- * @param currentTime Die gesendet Uhrzeit vom Master
- * @param alarmTime Die gesendete Alarmzeit vom Master
+ * @brief Kopiert BlackImage in einen freien Bildspeicher und reicht ihn mit dem
+ * geänderten Bereich an den Driver-Task weiter.
  */
-void printTimeScreen(String currentTime, String alarmTime) {
+void showFrame(RenderState *render, UBYTE *frame) {
+    if (render->nextPending) {
+        drawNextState(render);
+    }
+    if (render->dirtyX1 == 0) {
+        xQueueSend(freeFrames, &frame, 0);
+        return;
+    }
+    memcpy(frame, BlackImage, EPD_3IN52_WIDTH / 8 * EPD_3IN52_HEIGHT);
+
+    FrameJob job;
+    job.frame = frame;
+    job.x = render->dirtyX0;
+    job.y = render->dirtyY0;
+    job.w = render->dirtyX1 - render->dirtyX0;
+    job.h = render->dirtyY1 - render->dirtyY0;
+    render->dirtyX1 = 0;
+
+    renderStats.frames++;
+    xQueueSend(fullFrames, &job, portMAX_DELAY);
+    LOG_INFO("Bild %lu: Modus %u, %02u:%02u, Ausschnitt %u,%u %ux%u (%u Bytes), %lu Bytes vom Master",
+             (unsigned long)renderStats.frames, render->shown.mode, render->shown.hour, render->shown.min,
+             job.x, job.y, job.w, job.h, job.w / 8 * job.h, (unsigned long)render->linkBytes);
+    render->linkBytes = 0;
+}
 
-    Serial.println("printTime with time: " + currentTime + " and alarmTime: " + alarmTime);
+/**
+ * @brief Render-Task (Core 1): Wartet auf Nachrichten des Masters und übernimmt sie
+ * nach BlackImage (siehe applyMessage()). Muss danach ein neues Bild auf das Display,
+ * kopiert er BlackImage in einen leeren Bildspeicher und reicht ihn an den Driver-Task weiter.
+ * Ohne Nachrichten schlafen beide Tasks, es wird weder gezeichnet noch übertragen.
+ *
+ * Solange der Driver-Task noch refresht, ist kein Bildspeicher frei. Der Render-Task
+ * nimmt dann weiter Nachrichten an, damit die Ausschnitte des Masters nicht in der
+ * Queue verloren gehen. Von den Zuständen (z.B. vom Drehen am Encoder) wird nur der
+ * neueste gezeichnet. Das Display läuft dem Encoder so höchstens ein Bild hinterher,
+ * statt jede Raste einzeln nachzuholen.
+ */
+void renderTask(void *param) {
+    UBYTE *frame;
+    LinkMessage message;
+    RenderState render;
+    memset(&render, 0, sizeof(render));     // SCREEN_NONE, das Display zeigt noch den Splashscreen
 
-    if(alarmTime != "-") {
-        setActiveAlarm(true, alarmTime);
-    } else {
-        setActiveAlarm(false, alarmTime);
+    Paint_NewImage(BlackImage, EPD_3IN52_WIDTH, EPD_3IN52_HEIGHT, 270, WHITE);
+    Paint_Clear(WHITE);
+    // Das erste Bild ersetzt den ganzen Splashscreen, auch wenn es nur aus Ausschnitten besteht
+    markDirty(&render, 0, 0, EPD_3IN52_WIDTH, EPD_3IN52_HEIGHT);
+
+    for (;;) {
+        if (xQueueReceive(messages, &message, render.ready ? pdMS_TO_TICKS(RENDER_POLL_MS) : portMAX_DELAY) == pdTRUE) {
+            do {
+                if (applyMessage(&render, &message)) {
+                    render.ready = true;
+                }
+            } while (xQueueReceive(messages, &message, 0) == pdTRUE);
+        }
+        if (render.ready && xQueueReceive(freeFrames, &frame, 0) == pdTRUE) {
+            render.ready = false;
+            showFrame(&render, frame);
+        }
     }
-    Paint_DrawString_EN(35, getHorizontalCenter(80), currentTime.c_str(), &FontRoboto72, WHITE, BLACK);
 }
 
 /**
- * @brief Zeigt die Weckzeiteinstellug auf dem Display an.
- * 
- * @param alarmTime Die gesendete Alarmzeit vom Master
- * @param alarmState Der gesendete Alarmstatus vom Master (0 = in Bearbeitung, 1 = abgeschlossen)
+ * @brief Driver-Task (Core 0): Startet zuerst das Display, danach lädt er fertige
+ * Bilder auf das Display, refresht es und gibt den Bildspeicher wieder an den
+ * Render-Task zurück. Hat sich nur ein Teil des Bildes geändert, wird nur dieser
+ * Ausschnitt übertragen und refresht.
  */
-void printAlarmScreen(String alarmTime, boolean alarmState) {
+void driverTask(void *param) {
+    FrameJob job;
+    bool pending = bootDisplay(&job);
+    booting = false;
+
+    for (;;) {
+        if (!pending) {
+            xQueueReceive(fullFrames, &job, portMAX_DELAY);
+        }
+        pending = false;
+        bool full = job.w == EPD_3IN52_WIDTH && job.h == EPD_3IN52_HEIGHT;
+        uint32_t start = micros();
+
+        if (full) {
+            EPD_3IN52_display(job.frame);
+        } else {
+            EPD_3IN52_display_Partial(job.frame, job.x, job.y, job.w, job.h);
+        }
+        uint32_t transferred = micros();
+        quickRefresh();
+        if (!full) {
+            EPD_3IN52_PartialOut();
+        }
 
-    Serial.println("printAlarm with time: " + alarmTime + " and state: " + alarmState);
+        lastTransferUs = transferred - start;
+        lastRefreshUs = micros() - transferred;
+        transferBytes += job.w / 8 * job.h;
+        driverStats.busyUs += lastTransferUs + lastRefreshUs;
+        if (driverStats.frames++ == 0) {
+            firstFrameMs = esp_timer_get_time() / 1000;
+            LOG_INFO("Erstes Bild %lu ms nach dem Reset", (unsigned long)firstFrameMs);
+        }
+        xQueueSend(freeFrames, &job.frame, portMAX_DELAY);
+    }
+}
 
-    if(alarmState) {
-        Serial.println("AlarmState gesetzt");   
-        Paint_DrawString_EN(35, 22, "Set alarm", &FontRoboto13, WHITE, BLACK);
-        Paint_DrawString_EN(35, getHorizontalCenter(80), alarmTime.c_str(), &FontRoboto72, WHITE, BLACK);
-    // } else if(!alarmState) {
-    //     String time = "Successfully set at " + alarmTime;
-    //     Serial.println("STATE 1");
-    //     Paint_DrawString_EN(35, getHorizontalCenter(80), time.c_str(), &FontRoboto13, WHITE, BLACK);
-    //     delay(1000);
+/**
+ * @brief Startet die Pipeline. Alle Bildspeicher sind am Anfang leer.
+ */
+void startPipeline() {
+    freeFrames = xQueueCreate(FRAME_BUFFERS, sizeof(UBYTE *));
+    fullFrames = xQueueCreate(FRAME_BUFFERS, sizeof(FrameJob));
+    for (int i = 0; i < FRAME_BUFFERS; i++) {
+        xQueueSend(freeFrames, &FrameBuffers[i], 0);
+    }
+    xTaskCreatePinnedToCore(driverTask, "driver", 4096, NULL, 2, NULL, DRIVER_CORE);
+    if (messages != NULL) {
+        // Über loop(): Läuft loop(), wartet der Render-Task, siehe sleepIfIdle()
+        xTaskCreatePinnedToCore(renderTask, "render", 8192, NULL, 2, NULL, RENDER_CORE);
+    }
+}
+
+/**
+ * @brief Gibt die Auslastung beider Stufen seit dem letzten Aufruf aus.
+ * Die langsamere Stufe sollte nahe 100% liegen, dann bestimmt nur sie den Durchsatz.
+ */
+void printPipelineStats() {
+    static uint32_t lastUs = 0, lastRender = 0, lastDriver = 0, lastFrames = 0;
+    uint32_t now = micros();
+    uint32_t elapsed = now - lastUs;
+    uint32_t render = renderStats.busyUs, driver = driverStats.busyUs, frames = driverStats.frames;
+
+    if (lastUs != 0 && elapsed > 0) {
+        LOG_INFO("Pipeline: %.2f Bilder/s, Render %.1f%%, Driver %.1f%%, %lu Bilder übersprungen, %lu Nachrichten überholt",
+               (frames - lastFrames) * 1e6f / elapsed,
+               (render - lastRender) * 100.0f / elapsed,
+               (driver - lastDriver) * 100.0f / elapsed,
+               (unsigned long)skippedFrames, (unsigned long)coalescedMessages);
     }
+    LinkStats link;
+    PROTOCOL_STATS parser;
+    Link_GetStats(&link, &parser);
+    LOG_INFO("UART: %lu Bytes, %lu Frames, %lu CRC-Fehler, %lu Längenfehler, %lu Bytes übersprungen",
+           (unsigned long)link.Bytes, (unsigned long)parser.Frames, (unsigned long)parser.CrcErrors,
+           (unsigned long)parser.LengthErrors, (unsigned long)parser.Skipped);
+    LOG_INFO("UART: %lu FIFO-Überläufe, %lu Puffer voll, %lu Leitungsfehler, %lu Nachrichten verworfen",
+           (unsigned long)link.FifoOverflows, (unsigned long)link.BufferFull,
+           (unsigned long)link.LineErrors, (unsigned long)link.QueueDrops);
+    LOG_INFO("Ausschnitte: %lu gezeichnet, %lu verworfen, %lu nicht angenommen, %lu Bytes, %lu Bytes per SPI",
+           (unsigned long)regionMessages, (unsigned long)rejectedRegions, (unsigned long)link.RegionDrops,
+           (unsigned long)regionBytes, (unsigned long)transferBytes);
+    lastUs = now;
+    lastRender = render;
+    lastDriver = driver;
+    lastFrames = frames;
 }
 
 /**
- * @brief Erhält Daten vom Master, die mit "|" getrennt sind. Als erstes kommt der Control-Bit, dann die Daten.
- * 
- * 0 = Aktuelle Uhrzeit (Format: 0|hh:mm|?hh:mm)
- * 1 = Weckzeit einstellen (Format: 1|hh:mm|0||1)  
+ * @brief Gibt den Zustand des Heaps aus. Nach dem Start wird pro Nachricht kein
+ * Speicher mehr angefordert, im Dauertest müssen "frei" und "minimal" deshalb
+ * konstant bleiben. Sinkt der größte Block bei gleichem freien Speicher,
+ * ist der Heap fragmentiert.
  */
-void receiveControlBits()
-{
-    if (SerialPort.available()) {
-        msg = SerialPort.readStringUntil('\n');
+void printHeapStats() {
+    static uint32_t heapAtStart = 0;
+    uint32_t freeHeap = ESP.getFreeHeap();
+    uint32_t largestBlock = ESP.getMaxAllocHeap();
 
+    if (heapAtStart == 0) {
+        heapAtStart = freeHeap;
+    }
+    LOG_INFO("Heap: %lu Bytes frei (%ld seit Start), minimal %lu, größter Block %lu, Fragmentierung %.1f%%",
+           (unsigned long)freeHeap, (long)freeHeap - (long)heapAtStart,
+           (unsigned long)ESP.getMinFreeHeap(), (unsigned long)largestBlock,
+           freeHeap > 0 ? 100.0f - largestBlock * 100.0f / freeHeap : 0.0f);
+}
 
-        msg.remove(msg.length()-1, 1);
-        controlBit = getParam(msg, 0);
-        secondParam = getParam(msg, 1);
-        thirdParam = getParam(msg, 2);
+/**
+ * @brief Gibt aus, wie viel Zeit der ESP32 seit dem letzten Aufruf geschlafen hat.
+ */
+void printPowerStats() {
+    static int64_t lastUs = 0;
+    static uint64_t lastSleepUs = 0;
+    int64_t now = esp_timer_get_time();
+    PowerStats power;
+    Power_GetStats(&power);
+
+    if (lastUs != 0 && now > lastUs) {
+        float asleep = (power.sleepUs - lastSleepUs) * 100.0f / (now - lastUs);
+        LOG_INFO("Schlaf: %.1f%% geschlafen, %.1f%% wach, %lu mal geweckt (UART %lu, BUSY %lu, Timer %lu)",
+               asleep, 100.0f - asleep, (unsigned long)power.sleeps, (unsigned long)power.uartWakes,
+               (unsigned long)power.busyWakes, (unsigned long)power.timerWakes);
+    }
+    lastUs = now;
+    lastSleepUs = power.sleepUs;
+}
 
-        Serial.print("AVAILBABLE Received: " + msg);
+/**
+ * @brief Legt den ESP32 schlafen, wenn es nichts zu tun gibt: Der Empfang ruht, keine
+ * Nachricht wartet und alle Bildspeicher sind frei, es wird also weder gezeichnet noch
+ * übertragen. Wartet der Driver-Task nur noch auf das Ende eines Refreshs, darf der
+ * ESP32 ebenfalls schlafen, dann weckt ihn der BUSY-Pin. Solange das Display startet,
+ * bleibt er wach, der Splashscreen wartet auf FreeRTOS-Ticks. Ebenso, solange noch
+ * Ausgaben auf den Log-Task warten.
+ * Der Render-Task hat eine höhere Priorität als loop(). Läuft loop(), wartet er also.
+ *
+ * @param maxMs Spätestens nach dieser Zeit aufwachen
+ * @return PowerWake POWER_WAKE_NONE, wenn nicht geschlafen wurde
+ */
+PowerWake sleepIfIdle(uint32_t maxMs) {
+    if (booting || messages == NULL || !Link_IsIdle() || uxQueueMessagesWaiting(messages) > 0 || Log_Pending()) {
+        return POWER_WAKE_NONE;
     }
-    
-    if (controlBit == "0") {
-        printTimeScreen(secondParam, thirdParam);
+    bool waitForBusy = EPD_3IN52_Busy;
+    if (!waitForBusy && uxQueueMessagesWaiting(freeFrames) < FRAME_BUFFERS) {
+        return POWER_WAKE_NONE;
+    }
+    PowerWake wake = Power_Sleep(maxMs, waitForBusy);
+    if (wake == POWER_WAKE_UART) {
+        Link_Wake();
+    }
+    return wake;
+}
+
+/**
+ * @brief Schickt dem Master einen Bericht über den Zustand des Displays.
+ */
+void sendTelemetry() {
+    LinkStats link;
+    PROTOCOL_STATS parser;
+    Link_GetStats(&link, &parser);
+
+    PROTOCOL_TELEMETRY telemetry;
+    telemetry.Frames = driverStats.frames;
+    telemetry.RenderUs = lastRenderUs;
+    telemetry.TransferUs = lastTransferUs;
+    telemetry.TransferBytes = transferBytes;
+    telemetry.RefreshUs = lastRefreshUs;
+    telemetry.Skipped = skippedFrames;
+    telemetry.Coalesced = coalescedMessages;
+    telemetry.QueueDrops = link.QueueDrops;
+    telemetry.RxOverflows = link.FifoOverflows + link.BufferFull;
+    telemetry.RxErrors = parser.CrcErrors + parser.LengthErrors + link.LineErrors;
+    telemetry.FreeHeap = ESP.getFreeHeap();
+    telemetry.MinFreeHeap = ESP.getMinFreeHeap();
+
+    uint8_t frame[PROTOCOL_FRAME_SIZE(PROTOCOL_TELEMETRY_SIZE)];
+    if (!Link_Send(frame, Protocol_EncodeTelemetry(frame, sizeof(frame), &telemetry))) {
+        LOG_ERROR("Telemetrie konnte nicht gesendet werden");
     }
-    else if (controlBit == "1") {
-        printAlarmScreen(secondParam, true);
+}
+
+/**
+ * @brief Beantwortet Anfragen des Masters nach Telemetrie und schickt die Berichte
+ * im angefragten Abstand.
+ *
+ * @param maxMs So lange will loop() höchstens warten
+ * @return uint32_t So lange darf loop() warten, ohne einen Bericht zu verpassen
+ */
+uint32_t serviceTelemetry(uint32_t maxMs) {
+    static uint16_t interval = 0;      // Sekunden, 0 = keine regelmäßigen Berichte
+    static uint32_t lastReport = 0;
+    uint16_t requested;
+
+    if (Link_TelemetryRequested(&requested)) {
+        interval = requested;
+        sendTelemetry();
+        lastReport = millis();
+    } else if (interval > 0 && millis() - lastReport >= interval * 1000UL) {
+        sendTelemetry();
+        lastReport = millis();
     }
+
+    if (interval > 0) {
+        uint32_t due = interval * 1000UL - (millis() - lastReport);
+        if (due < maxMs) {
+            maxMs = due;
+        }
+    }
+    return maxMs;
 }
 
 void setup() {
     // Wifi connection
     Serial.begin(115200);
-    SerialPort.begin(115200, SERIAL_8N1, 16, 17);
+    // Ausgaben landen im Ringpuffer und werden von einem eigenen Task geschrieben
+    Log_Start();
+    // UART2 zum Master, der Empfang läuft ab hier im Link-Task
+    messages = Link_Start();
     //tickerObject.start(); 
 
-    // ESP32 und EPD werden initialisiert
+    // Die Pins des ESP32 werden initialisiert, das Display startet erst der Driver-Task
     DEV_Module_Init();
-    EPD_3IN52_Init();
-    fullRefresh();
-
-    EPD_3IN52_SendCommand(0x50);    // KEINE Ahnung was die Hexadezimalzahlen für Befehle sein sollen, aber ist wichtig
-    EPD_3IN52_SendData(0x17);       // KEINE Ahnung was die Hexadezimalzahlen für Befehle sein sollen, aber ist wichtig
 
     // Der schwarz-weiß-Bildspeicher wird initialisiert (was genau passiert: keine Ahnung, aber das braucht es)
     UWORD Imagesize = ((EPD_3IN52_WIDTH % 8 == 0)? (EPD_3IN52_WIDTH / 8 ): (EPD_3IN52_WIDTH / 8 + 1)) * EPD_3IN52_HEIGHT;
     if((BlackImage = (UBYTE *)malloc(Imagesize)) == NULL) {
-        printf("Failed to apply for black memory...\r\n");
+        LOG_ERROR("Failed to apply for black memory...");
+    }
+    // Dazu kommen die Bildspeicher der Pipeline, in die der Render-Task BlackImage für den Driver-Task kopiert
+    for (int i = 0; i < FRAME_BUFFERS; i++) {
+        if((FrameBuffers[i] = (UBYTE *)malloc(Imagesize)) == NULL) {
+            LOG_ERROR("Failed to apply for frame memory...");
+        }
     }
 
-    displaySplashScreen();
+    // Die Ziffern der Uhr werden nur einmal gerastert und danach aus dem Cache kopiert
+    GlyphCache_Init(&GlyphCache, GLYPH_CACHE_BUDGET);
+    Paint_SetGlyphCache(&GlyphCache);
+
+    // Ab hier zeichnet der Render-Task und nur noch der Driver-Task spricht mit dem Display.
+    // Er startet das Display und zeigt den Splashscreen, setup() wartet nicht darauf.
+    startPipeline();
+    printHeapStats();
 }
 
 void loop()
 {   
-    // Hier wird das neue Bild erstellt...
-    Paint_NewImage(BlackImage, EPD_3IN52_WIDTH, EPD_3IN52_HEIGHT, 270, WHITE);
-
-    // ... mit der Hintergrundfarbe weiß...
-    Paint_Clear(WHITE);
-
-    // ... und dem Inhalt von der Funktion receiveControlBits()...
-    receiveControlBits();
-
-    // ... und hier wird das Bild dann auf das Display geladen und dargestellt
-    EPD_3IN52_display(BlackImage);
-   
-    // Refresht das Display um auf Änderungen zu reagieren
-    quickRefresh();
-}
\ No newline at end of file
+    // Das Zeichnen und Übertragen läuft in renderTask() und driverTask(), hier wird nur die Auslastung ausgegeben,
+    // die Telemetrie gesendet und dazwischen geschlafen
+    printPipelineStats();
+    printHeapStats();
+    printPowerStats();
+
+    // Bis zur nächsten Ausgabe schlafen, so oft es geht, und zwischendurch die Telemetrie senden
+    uint32_t start = millis();
+    while (millis() - start < STATS_INTERVAL_MS) {
+        uint32_t wait = serviceTelemetry(STATS_INTERVAL_MS - (millis() - start));
+        if (sleepIfIdle(wait) == POWER_WAKE_NONE) {
+            delay(POWER_POLL_MS);
+        }
+    }
+}
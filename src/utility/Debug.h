@@ -14,11 +14,24 @@
 #ifndef __DEBUG_H
 #define __DEBUG_H
 
+#ifdef ARDUINO
 #include <Wire.h>
+#include "DayriseLog.h"
+#else
+#include <stdio.h>
+#endif
 
+/**
+ * On the ESP32 the messages go through the deferred logger at debug level,
+ * so they cost nothing unless built with -DLOG_LEVEL=LOG_LEVEL_DEBUG.
+**/
+#ifndef USE_DEBUG
 #define USE_DEBUG 1
-#if USE_DEBUG
-	#define Debug(__info) Serial.print(__info)
+#endif
+#if USE_DEBUG && defined(ARDUINO)
+	#define Debug(__info) LOG_DEBUG("%s", __info)
+#elif USE_DEBUG
+	#define Debug(__info) printf("%s", __info)
 #else
 	#define Debug(__info)  
 #endif
@@ -190,7 +190,67 @@ static const UBYTE EPD_3IN52_lut_bb[] =
   0x00,0x00,0x00,0x00,0x00,0x00,0x00
 };
 
+/**
+ * 4 gray LUTs, R20 vcom, R21 ww, R22 bw, R23 wb, R24 bb
+ * The plane sent with 0x10 selects old = w/b, the plane sent with 0x13
+ * selects new = w/b, so each of the four pixel values gets its own waveform:
+ * ww = white, wb = light gray, bw = dark gray, bb = black.
+ * ww and bb are the full waveforms from above, the two grays stop the second
+ * drive phase early. The phase lengths are a starting point and still have
+ * to be tuned on the panel.
+**/
+static const UBYTE EPD_3IN52_lut_4Gray_vcom[] =
+{
+  0x01,0x19,0x19,0x19,0x19,0x01,0x01,
+  0x01,0x19,0x19,0x19,0x01,0x01,0x01,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00
+};
+
+static const UBYTE EPD_3IN52_lut_4Gray_ww[] =
+{
+  0x01,0x59,0x99,0x59,0x99,0x01,0x01,
+  0x01,0x59,0x99,0x19,0x01,0x01,0x01,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00
+};
+
+static const UBYTE EPD_3IN52_lut_4Gray_bw[] =
+{
+  0x01,0x19,0x99,0x59,0x99,0x01,0x01,
+  0x01,0x59,0x09,0x00,0x01,0x01,0x01,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00
+};
+
+static const UBYTE EPD_3IN52_lut_4Gray_wb[] =
+{
+  0x01,0x59,0x99,0x59,0x99,0x01,0x01,
+  0x01,0x19,0x09,0x00,0x01,0x01,0x01,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00
+};
+
+static const UBYTE EPD_3IN52_lut_4Gray_bb[] =
+{
+  0x01,0x19,0x99,0x59,0x99,0x01,0x01,
+  0x01,0x59,0x99,0x59,0x01,0x01,0x01,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+  0x00,0x00,0x00,0x00,0x00,0x00,0x00
+};
+
 unsigned char EPD_3IN52_Flag = 0;
+volatile UBYTE EPD_3IN52_Busy = 0;
 
 /******************************************************************************
 function :	Software reset
@@ -235,14 +295,18 @@ void EPD_3IN52_SendData(UBYTE Data)
 /******************************************************************************
 function :	Read Busy
 parameter:
+info:
+    Polls once per millisecond instead of spinning, so the CPU is free (or
+    asleep, woken by the BUSY pin) while the panel refreshes.
 ******************************************************************************/
 void EPD_3IN52_ReadBusy(void)
 {
     //Debug("e-Paper busy\r\n");
-    UBYTE busy;
-    do {
-        busy = DEV_Digital_Read(EPD_BUSY_PIN);
-    } while(!busy);
+    EPD_3IN52_Busy = 1;
+    while(!DEV_Digital_Read(EPD_BUSY_PIN)) {
+        DEV_Delay_ms(1);
+    }
+    EPD_3IN52_Busy = 0;
     DEV_Delay_ms(200);
     //Debug("e-Paper busy release\r\n");
 }
@@ -416,6 +480,44 @@ void EPD_3IN52_lut_DU(void)
 
 
 
+/******************************************************************************
+function :	Load the 4 gray LUTs, see EPD_3IN52_display_4Gray()
+parameter:
+******************************************************************************/
+void EPD_3IN52_lut_4Gray(void)
+{
+    UBYTE count;
+    EPD_3IN52_SendCommand(0x20);        // vcom
+    for(count = 0; count < 42 ; count++)
+    {
+        EPD_3IN52_SendData(EPD_3IN52_lut_4Gray_vcom[count]);
+    }
+
+    EPD_3IN52_SendCommand(0x21);        // ww  white
+    for(count = 0; count < 42 ; count++)
+    {
+        EPD_3IN52_SendData(EPD_3IN52_lut_4Gray_ww[count]);
+    }
+
+    EPD_3IN52_SendCommand(0x22);        // bw  dark gray
+    for(count = 0; count < 42 ; count++)
+    {
+        EPD_3IN52_SendData(EPD_3IN52_lut_4Gray_bw[count]);
+    }
+
+    EPD_3IN52_SendCommand(0x23);        // wb  light gray
+    for(count = 0; count < 42 ; count++)
+    {
+        EPD_3IN52_SendData(EPD_3IN52_lut_4Gray_wb[count]);
+    }
+
+    EPD_3IN52_SendCommand(0x24);        // bb  black
+    for(count = 0; count < 42 ; count++)
+    {
+        EPD_3IN52_SendData(EPD_3IN52_lut_4Gray_bb[count]);
+    }
+}
+
 /******************************************************************************
 function :	Initialize the e-Paper register
 parameter:
@@ -474,6 +576,108 @@ void EPD_3IN52_display(UBYTE* picData)
     }
 }
 
+/******************************************************************************
+function :	Send one window of the framebuffer for a partial refresh
+parameter:
+    Image  : The whole framebuffer, only the window is sent
+    Xstart : First column, a multiple of 8
+    Ystart : First row
+    Width  : Columns, a multiple of 8
+    Height : Rows
+info:
+    Enters the partial mode (0x91), sets the window (0x90) and sends its
+    rows as new data. Follow with EPD_3IN52_refresh(), which then only
+    drives the window, and EPD_3IN52_PartialOut(). The panel keeps the
+    pixels outside the window.
+******************************************************************************/
+void EPD_3IN52_display_Partial(const UBYTE* Image, UWORD Xstart, UWORD Ystart, UWORD Width, UWORD Height)
+{
+    UWORD Xend = Xstart + Width - 1;
+    UWORD Yend = Ystart + Height - 1;
+
+    EPD_3IN52_SendCommand(0x91);		// partial in   PTIN
+    EPD_3IN52_SendCommand(0x90);		// partial window   PTL
+    EPD_3IN52_SendData(Xstart & 0xF8);	//  HRST[7:3] 0 0 0
+    EPD_3IN52_SendData(Xend | 0x07);	//  HRED[7:3] 1 1 1
+    EPD_3IN52_SendData(Ystart >> 8);	//  x x x x x x x VRST[8]
+    EPD_3IN52_SendData(Ystart & 0xFF);	//  VRST[7:0]
+    EPD_3IN52_SendData(Yend >> 8);		//  x x x x x x x VRED[8]
+    EPD_3IN52_SendData(Yend & 0xFF);	//  VRED[7:0]
+    EPD_3IN52_SendData(0x01);			//  x x x x x x x PT_SCAN
+
+    EPD_3IN52_SendCommand(0x13);		     //Transfer new data
+    for(UWORD y = Ystart; y <= Yend; y++)
+    {
+        const UBYTE *Row = Image + (UDOUBLE)y * (EPD_3IN52_WIDTH / 8) + Xstart / 8;
+        for(UWORD x = 0; x < Width / 8; x++)
+            EPD_3IN52_SendData(Row[x]);
+    }
+}
+
+/******************************************************************************
+function :	Leave the partial mode after the refresh of a window
+******************************************************************************/
+void EPD_3IN52_PartialOut(void)
+{
+    EPD_3IN52_SendCommand(0x92);		// partial out   PTOUT
+}
+
+/******************************************************************************
+function :	Stream a PackBits compressed image to the display
+parameter:
+    rleData : Compressed image in framebuffer layout, see Paint_DrawBitMap_RLE()
+info:
+    The image is decoded straight into the SPI transfer, no framebuffer is
+    needed. Decoding stops after one full frame.
+******************************************************************************/
+void EPD_3IN52_display_RLE(const UBYTE* rleData)
+{
+    UWORD remaining = EPD_3IN52_WIDTH*EPD_3IN52_HEIGHT/8;
+    EPD_3IN52_SendCommand(0x13);		     //Transfer new data
+    while(remaining > 0)
+    {
+        UBYTE n = *rleData++;
+        if(n < 128) {
+            for(UWORD i = 0; i <= n && remaining > 0; i++, remaining--)
+                EPD_3IN52_SendData(rleData[i]);
+            rleData += n + 1;
+        } else if(n > 128) {
+            UBYTE value = *rleData++;
+            for(UWORD i = 0; i < 257 - n && remaining > 0; i++, remaining--)
+                EPD_3IN52_SendData(value);
+        }
+    }
+}
+
+/******************************************************************************
+function :	Send a 4 gray framebuffer as two bit planes
+parameter:
+    Image : Framebuffer drawn with Paint_SetScale(4), 2 bits per pixel,
+            3 = white (WHITE % 4) ... 0 = black (BLACK % 4)
+info:
+    The high bits go to 0x10 (old data), the low bits to 0x13 (new data).
+    Each 32 bit word of 16 pixels is split with EPD_3IN52_GrayPlane16(),
+    no plane buffer is needed. Show it with EPD_3IN52_lut_4Gray() and
+    EPD_3IN52_refresh(). The next 1-bpp frame needs a full refresh, because
+    the old data of the panel then holds the high bit plane.
+******************************************************************************/
+void EPD_3IN52_display_4Gray(const UBYTE* Image)
+{
+    static const UBYTE Command[2] = {0x10, 0x13};
+    for(UBYTE plane = 0; plane < 2; plane++)
+    {
+        const UBYTE *p = Image;
+        EPD_3IN52_SendCommand(Command[plane]);
+        for(UWORD i = 0; i < EPD_3IN52_WIDTH*EPD_3IN52_HEIGHT/16; i++, p += 4)
+        {
+            UDOUBLE Pixels = ((UDOUBLE)p[0] << 24) | ((UDOUBLE)p[1] << 16) | ((UDOUBLE)p[2] << 8) | p[3];
+            UWORD Bits = EPD_3IN52_GrayPlane16(Pixels, 1 - plane);
+            EPD_3IN52_SendData(Bits >> 8);
+            EPD_3IN52_SendData(Bits & 0xFF);
+        }
+    }
+}
+
 void EPD_3IN52_display_NUM(UBYTE NUM)
 {
     UWORD row, column;
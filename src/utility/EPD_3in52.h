@@ -53,14 +53,38 @@
 
 
 extern unsigned char EPD_3IN52_Flag;
+extern volatile UBYTE EPD_3IN52_Busy;  // 1 while EPD_3IN52_ReadBusy() waits for the panel
+
+/**
+ * One bit plane of 16 pixels of a 4 gray framebuffer
+ * Pixels : 4 framebuffer bytes, the first byte in the highest bits
+ * Bit    : 1 = high bits, 0 = low bits of the pixels
+ * return : 16 bits, the first pixel in the highest bit
+ * The selected bits are moved together in five shift/mask steps instead of
+ * one test per pixel.
+**/
+static inline UWORD EPD_3IN52_GrayPlane16(UDOUBLE Pixels, UBYTE Bit)
+{
+    UDOUBLE x = (Pixels >> Bit) & 0x55555555;
+    x = (x | (x >> 1)) & 0x33333333;
+    x = (x | (x >> 2)) & 0x0F0F0F0F;
+    x = (x | (x >> 4)) & 0x00FF00FF;
+    x = (x | (x >> 8)) & 0x0000FFFF;
+    return (UWORD)x;
+}
 
 void EPD_3IN52_SendCommand(UBYTE Reg);
 void EPD_3IN52_SendData(UBYTE Data);
 void EPD_3IN52_refresh(void);
 void EPD_3IN52_lut_GC(void);
 void EPD_3IN52_lut_DU(void);
+void EPD_3IN52_lut_4Gray(void);
 void EPD_3IN52_Init(void);
 void EPD_3IN52_display(UBYTE* picData);
+void EPD_3IN52_display_RLE(const UBYTE* rleData);
+void EPD_3IN52_display_Partial(const UBYTE* Image, UWORD Xstart, UWORD Ystart, UWORD Width, UWORD Height);
+void EPD_3IN52_PartialOut(void);
+void EPD_3IN52_display_4Gray(const UBYTE* Image);
 void EPD_3IN52_display_NUM(UBYTE NUM);
 void EPD_3IN52_Clear(void);
 void EPD_3IN52_sleep(void);
@@ -0,0 +1,281 @@
+/******************************************************************************
+* | File      	:   test_paint_spans.cpp
+* | Function    :   Span fills of the Paint layer against the pixel-by-pixel code
+* | Info        :
+*   pio test -e native -f test_paint_spans
+*   The Ref_*() functions are the Waveshare shape code from before the span
+*   fills, drawing every pixel with PaintCtx_SetPixel(). Random scenes of
+*   lines, dots, rectangles, circles and windows are drawn with both, in all
+*   rotations and mirrors on scales 2 and 4, and the framebuffers must be
+*   identical. Shapes partly off the canvas are included, they take the
+*   fallback paths.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-07-20
+* | Info        :
+*
+******************************************************************************/
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "GUI_Paint.h"
+#include "EPD.h"
+
+#define SCENES          100     // Per rotation, mirror and scale
+#define SHAPES          12      // Per scene
+
+//Scale 4 needs 2 bits per pixel. PaintCtx_SetPixel() lets X == WidthMemory
+//and Y == HeightMemory through, like the Waveshare original, so shapes on
+//the edge write up to one row behind the framebuffer. The padding takes
+//those writes and is compared as well.
+#define IMAGE_SIZE      (EPD_3IN52_WIDTH * EPD_3IN52_HEIGHT / 4)
+#define PADDING         (2 * EPD_3IN52_WIDTH / 4)
+static UBYTE Fast[IMAGE_SIZE + PADDING];
+static UBYTE Slow[IMAGE_SIZE + PADDING];
+static PaintContext FastCtx, SlowCtx;
+
+/******************************************************************************
+function: Reference shapes, one PaintCtx_SetPixel() per pixel
+******************************************************************************/
+static void Ref_ClearWindows(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color)
+{
+    for (UWORD Y = Ystart; Y < Yend; Y++)
+        for (UWORD X = Xstart; X < Xend; X++)
+            PaintCtx_SetPixel(Ctx, X, Y, Color);
+}
+
+static void Ref_DrawPoint(PaintContext *Ctx, UWORD Xpoint, UWORD Ypoint, UWORD Color,
+                          DOT_PIXEL Dot_Pixel, DOT_STYLE Dot_Style)
+{
+    if (Xpoint > Ctx->Width || Ypoint > Ctx->Height)
+        return;
+
+    int16_t XDir_Num, YDir_Num;
+    if (Dot_Style == DOT_FILL_AROUND) {
+        for (XDir_Num = 0; XDir_Num < 2 * Dot_Pixel - 1; XDir_Num++) {
+            for (YDir_Num = 0; YDir_Num < 2 * Dot_Pixel - 1; YDir_Num++) {
+                if (Xpoint + XDir_Num - Dot_Pixel < 0 || Ypoint + YDir_Num - Dot_Pixel < 0)
+                    break;
+                PaintCtx_SetPixel(Ctx, Xpoint + XDir_Num - Dot_Pixel, Ypoint + YDir_Num - Dot_Pixel, Color);
+            }
+        }
+    } else {
+        for (XDir_Num = 0; XDir_Num < Dot_Pixel; XDir_Num++)
+            for (YDir_Num = 0; YDir_Num < Dot_Pixel; YDir_Num++)
+                PaintCtx_SetPixel(Ctx, Xpoint + XDir_Num - 1, Ypoint + YDir_Num - 1, Color);
+    }
+}
+
+static void Ref_DrawLine(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+                         UWORD Color, DOT_PIXEL Line_width, LINE_STYLE Line_Style)
+{
+    if (Xstart > Ctx->Width || Ystart > Ctx->Height || Xend > Ctx->Width || Yend > Ctx->Height)
+        return;
+
+    UWORD Xpoint = Xstart;
+    UWORD Ypoint = Ystart;
+    int dx = (int)Xend - (int)Xstart >= 0 ? Xend - Xstart : Xstart - Xend;
+    int dy = (int)Yend - (int)Ystart <= 0 ? Yend - Ystart : Ystart - Yend;
+    int XAddway = Xstart < Xend ? 1 : -1;
+    int YAddway = Ystart < Yend ? 1 : -1;
+    int Esp = dx + dy;
+    char Dotted_Len = 0;
+
+    for (;;) {
+        Dotted_Len++;
+        if (Line_Style == LINE_STYLE_DOTTED && Dotted_Len % 3 == 0) {
+            Ref_DrawPoint(Ctx, Xpoint, Ypoint, IMAGE_BACKGROUND, Line_width, DOT_STYLE_DFT);
+            Dotted_Len = 0;
+        } else {
+            Ref_DrawPoint(Ctx, Xpoint, Ypoint, Color, Line_width, DOT_STYLE_DFT);
+        }
+        if (2 * Esp >= dy) {
+            if (Xpoint == Xend)
+                break;
+            Esp += dy;
+            Xpoint += XAddway;
+        }
+        if (2 * Esp <= dx) {
+            if (Ypoint == Yend)
+                break;
+            Esp += dx;
+            Ypoint += YAddway;
+        }
+    }
+}
+
+static void Ref_DrawRectangle(PaintContext *Ctx, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend,
+                              UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
+{
+    if (Xstart > Ctx->Width || Ystart > Ctx->Height || Xend > Ctx->Width || Yend > Ctx->Height)
+        return;
+
+    if (Draw_Fill) {
+        for (UWORD Ypoint = Ystart; Ypoint < Yend; Ypoint++)
+            Ref_DrawLine(Ctx, Xstart, Ypoint, Xend, Ypoint, Color, Line_width, LINE_STYLE_SOLID);
+    } else {
+        Ref_DrawLine(Ctx, Xstart, Ystart, Xend, Ystart, Color, Line_width, LINE_STYLE_SOLID);
+        Ref_DrawLine(Ctx, Xstart, Ystart, Xstart, Yend, Color, Line_width, LINE_STYLE_SOLID);
+        Ref_DrawLine(Ctx, Xend, Yend, Xend, Ystart, Color, Line_width, LINE_STYLE_SOLID);
+        Ref_DrawLine(Ctx, Xend, Yend, Xstart, Yend, Color, Line_width, LINE_STYLE_SOLID);
+    }
+}
+
+static void Ref_DrawCircle(PaintContext *Ctx, UWORD X_Center, UWORD Y_Center, UWORD Radius,
+                           UWORD Color, DOT_PIXEL Line_width, DRAW_FILL Draw_Fill)
+{
+    if (X_Center > Ctx->Width || Y_Center >= Ctx->Height)
+        return;
+
+    int16_t XCurrent = 0;
+    int16_t YCurrent = Radius;
+    int16_t Esp = 3 - (Radius << 1);
+
+    while (XCurrent <= YCurrent) {
+        if (Draw_Fill == DRAW_FILL_FULL) {
+            for (int16_t sCountY = XCurrent; sCountY <= YCurrent; sCountY++) {
+                Ref_DrawPoint(Ctx, X_Center + XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+                Ref_DrawPoint(Ctx, X_Center - XCurrent, Y_Center + sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+                Ref_DrawPoint(Ctx, X_Center - sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+                Ref_DrawPoint(Ctx, X_Center - sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+                Ref_DrawPoint(Ctx, X_Center - XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+                Ref_DrawPoint(Ctx, X_Center + XCurrent, Y_Center - sCountY, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+                Ref_DrawPoint(Ctx, X_Center + sCountY, Y_Center - XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+                Ref_DrawPoint(Ctx, X_Center + sCountY, Y_Center + XCurrent, Color, DOT_PIXEL_DFT, DOT_STYLE_DFT);
+            }
+        } else {
+            Ref_DrawPoint(Ctx, X_Center + XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);
+            Ref_DrawPoint(Ctx, X_Center - XCurrent, Y_Center + YCurrent, Color, Line_width, DOT_STYLE_DFT);
+            Ref_DrawPoint(Ctx, X_Center - YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);
+            Ref_DrawPoint(Ctx, X_Center - YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);
+            Ref_DrawPoint(Ctx, X_Center - XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);
+            Ref_DrawPoint(Ctx, X_Center + XCurrent, Y_Center - YCurrent, Color, Line_width, DOT_STYLE_DFT);
+            Ref_DrawPoint(Ctx, X_Center + YCurrent, Y_Center - XCurrent, Color, Line_width, DOT_STYLE_DFT);
+            Ref_DrawPoint(Ctx, X_Center + YCurrent, Y_Center + XCurrent, Color, Line_width, DOT_STYLE_DFT);
+        }
+        if (Esp < 0)
+            Esp += 4 * XCurrent + 6;
+        else {
+            Esp += 10 + 4 * (XCurrent - YCurrent);
+            YCurrent--;
+        }
+        XCurrent++;
+    }
+}
+
+/******************************************************************************
+function: Random scene helpers
+******************************************************************************/
+static UWORD Coord(UWORD Max)
+{
+    //Mostly on the canvas, sometimes on or just past its last pixel
+    return (rand() % 8 == 0) ? Max - 2 + rand() % 4 : rand() % Max;
+}
+
+static UWORD RandomColor(UBYTE Scale)
+{
+    static const UWORD Colors[4] = {BLACK, WHITE, 1, 2};
+    return Colors[rand() % (Scale == 4 ? 4 : 2)];
+}
+
+static void NewCanvas(PaintContext *Ctx, UBYTE *Image, UWORD Rotate, UBYTE Mirror, UBYTE Scale)
+{
+    memset(Image, 0, IMAGE_SIZE + PADDING);
+    PaintCtx_NewImage(Ctx, Image, EPD_3IN52_WIDTH, EPD_3IN52_HEIGHT, Rotate, WHITE);
+    PaintCtx_SetScale(Ctx, Scale);
+    PaintCtx_SetMirroring(Ctx, Mirror);
+    PaintCtx_Clear(Ctx, WHITE);
+}
+
+/******************************************************************************
+function: Draw one random shape with both implementations
+******************************************************************************/
+static void DrawShape(UBYTE Scale)
+{
+    UWORD W = FastCtx.Width, H = FastCtx.Height;
+    UWORD X1 = Coord(W), Y1 = Coord(H), X2 = Coord(W), Y2 = Coord(H);
+    UWORD Color = RandomColor(Scale);
+    DOT_PIXEL Width = (DOT_PIXEL)(1 + rand() % 8);
+    UBYTE Kind = rand() % 8;
+
+    //Half of the lines axis-aligned, those take the span fill
+    if (Kind <= 2 && rand() % 2)
+        (rand() % 2) ? (Y2 = Y1) : (X2 = X1);
+
+    switch (Kind) {
+    case 0:
+    case 1: {
+        LINE_STYLE Style = (rand() % 4 == 0) ? LINE_STYLE_DOTTED : LINE_STYLE_SOLID;
+        PaintCtx_DrawLine(&FastCtx, X1, Y1, X2, Y2, Color, Width, Style);
+        Ref_DrawLine(&SlowCtx, X1, Y1, X2, Y2, Color, Width, Style);
+        break;
+    }
+    case 2: {
+        DRAW_FILL Fill = (DRAW_FILL)(rand() % 2);
+        PaintCtx_DrawRectangle(&FastCtx, X1, Y1, X2, Y2, Color, Width, Fill);
+        Ref_DrawRectangle(&SlowCtx, X1, Y1, X2, Y2, Color, Width, Fill);
+        break;
+    }
+    case 3:
+    case 4: {
+        UWORD Radius = rand() % 80;
+        DRAW_FILL Fill = (DRAW_FILL)(rand() % 2);
+        PaintCtx_DrawCircle(&FastCtx, X1, Y1, Radius, Color, Width, Fill);
+        Ref_DrawCircle(&SlowCtx, X1, Y1, Radius, Color, Width, Fill);
+        break;
+    }
+    case 5:
+    case 6: {
+        DOT_STYLE Style = (rand() % 2) ? DOT_FILL_AROUND : DOT_FILL_RIGHTUP;
+        PaintCtx_DrawPoint(&FastCtx, X1, Y1, Color, Width, Style);
+        Ref_DrawPoint(&SlowCtx, X1, Y1, Color, Width, Style);
+        break;
+    }
+    default:
+        PaintCtx_ClearWindows(&FastCtx, X1, Y1, X2, Y2, Color);
+        Ref_ClearWindows(&SlowCtx, X1, Y1, X2, Y2, Color);
+        break;
+    }
+}
+
+static void CheckScenes(UBYTE Scale)
+{
+    static const UWORD Rotations[4] = {ROTATE_0, ROTATE_90, ROTATE_180, ROTATE_270};
+    char Message[96];
+    srand(Scale);
+    for (UBYTE r = 0; r < 4; r++) {
+        for (UBYTE Mirror = MIRROR_NONE; Mirror <= MIRROR_ORIGIN; Mirror++) {
+            for (UWORD Scene = 0; Scene < SCENES; Scene++) {
+                NewCanvas(&FastCtx, Fast, Rotations[r], Mirror, Scale);
+                NewCanvas(&SlowCtx, Slow, Rotations[r], Mirror, Scale);
+                for (UBYTE i = 0; i < SHAPES; i++)
+                    DrawShape(Scale);
+                snprintf(Message, sizeof(Message), "scale %u, rotate %u, mirror %u, scene %u",
+                         Scale, Rotations[r], Mirror, Scene);
+                TEST_ASSERT_EQUAL_MEMORY_MESSAGE(Slow, Fast, sizeof(Fast), Message);
+            }
+        }
+    }
+}
+
+static void test_spans_scale2(void)
+{
+    CheckScenes(2);
+}
+
+static void test_spans_scale4(void)
+{
+    CheckScenes(4);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_spans_scale2);
+    RUN_TEST(test_spans_scale4);
+    return UNITY_END();
+}
@@ -0,0 +1,224 @@
+/******************************************************************************
+* | File      	:   test_protocol.cpp
+* | Function    :   Parser and codecs of lib/DayriseProtocol
+* | Info        :
+*   pio test -e native -f test_protocol
+*   Random streams of frames with garbage, stray sync bytes and every Nth
+*   frame damaged are fed to the parser in pieces of random size. Every
+*   intact frame must arrive, in order, and no damaged one.
+*----------------
+* |	This version:   V1.0
+* | Date        :   2023-07-20
+* | Info        :
+*
+******************************************************************************/
+#include <unity.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "DayriseProtocol.h"
+
+#define STREAMS         2000
+#define FRAMES          20      // Per stream
+#define CORRUPT_EVERY   5       // Every Nth frame gets one bit flipped
+#define MAX_CHUNK       64      // Largest piece handed to Protocol_Feed()
+
+typedef struct {
+    uint8_t Type;
+    std::vector<uint8_t> Payload;
+} Message;
+
+static std::vector<Message> Received;
+
+static void OnFrame(void *Arg, const PROTOCOL_FRAME *Frame)
+{
+    Message m;
+    m.Type = Frame->Type;
+    m.Payload.assign(Frame->Payload, Frame->Payload + Frame->Len);
+    Received.push_back(m);
+}
+
+/******************************************************************************
+function: Feed a stream in pieces of random size, then let the line go quiet
+******************************************************************************/
+static void FeedSplit(PROTOCOL_PARSER *Parser, const std::vector<uint8_t> &Stream)
+{
+    size_t pos = 0;
+    while (pos < Stream.size()) {
+        size_t len = 1 + rand() % MAX_CHUNK;
+        if (len > Stream.size() - pos)
+            len = Stream.size() - pos;
+        Protocol_Feed(Parser, Stream.data() + pos, len, OnFrame, NULL);
+        pos += len;
+    }
+    Protocol_Idle(Parser, OnFrame, NULL);
+}
+
+/******************************************************************************
+function: Garbage between frames, with stray sync bytes
+******************************************************************************/
+static void AppendGarbage(std::vector<uint8_t> &Stream)
+{
+    int len = rand() % 12;
+    for (int i = 0; i < len; i++)
+        Stream.push_back(rand() % 4 == 0 ? PROTOCOL_SYNC : rand() % 256);
+}
+
+static void test_split_garbage_and_corruption(void)
+{
+    uint8_t Frame[PROTOCOL_FRAME_SIZE(PROTOCOL_MAX_PAYLOAD)];
+    uint32_t Damaged = 0;
+    srand(41);
+
+    for (int s = 0; s < STREAMS; s++) {
+        std::vector<uint8_t> Stream;
+        std::vector<Message> Expected;
+        PROTOCOL_PARSER Parser;
+        Protocol_Init(&Parser);
+        Received.clear();
+
+        for (int f = 0; f < FRAMES; f++) {
+            Message m;
+            m.Type = rand() % 256;
+            //Mostly short frames like the time messages, sometimes up to the limit
+            uint16_t Len = (rand() % 8 == 0) ? rand() % (PROTOCOL_MAX_PAYLOAD + 1) : rand() % 16;
+            for (uint16_t i = 0; i < Len; i++)
+                m.Payload.push_back(rand() % 4 == 0 ? PROTOCOL_SYNC : rand() % 256);
+            uint16_t Size = Protocol_Encode(Frame, sizeof(Frame), m.Type, m.Payload.data(), Len);
+            TEST_ASSERT_EQUAL_UINT16(PROTOCOL_FRAME_SIZE(Len), Size);
+
+            if (f % CORRUPT_EVERY == CORRUPT_EVERY - 1) {
+                //One bit anywhere behind the sync byte: type, length, payload or CRC
+                uint16_t Byte = 1 + rand() % (Size - 1);
+                Frame[Byte] ^= 1 << (rand() % 8);
+                Damaged++;
+            } else {
+                Expected.push_back(m);
+            }
+            AppendGarbage(Stream);
+            Stream.insert(Stream.end(), Frame, Frame + Size);
+        }
+        AppendGarbage(Stream);
+        FeedSplit(&Parser, Stream);
+
+        TEST_ASSERT_EQUAL_UINT32(Expected.size(), Received.size());
+        for (size_t i = 0; i < Expected.size(); i++) {
+            TEST_ASSERT_EQUAL_UINT8(Expected[i].Type, Received[i].Type);
+            TEST_ASSERT_EQUAL_UINT32(Expected[i].Payload.size(), Received[i].Payload.size());
+            if (!Expected[i].Payload.empty())
+                TEST_ASSERT_EQUAL_MEMORY(Expected[i].Payload.data(), Received[i].Payload.data(), Expected[i].Payload.size());
+        }
+        TEST_ASSERT_EQUAL_UINT32(Expected.size(), Parser.Stats.Frames);
+        TEST_ASSERT_FALSE(Parser.Synced && Parser.Pending > 0);
+    }
+    TEST_ASSERT_TRUE(Damaged > 0);
+}
+
+static void test_oversized_length_is_rejected(void)
+{
+    //Sync, type, length PROTOCOL_MAX_PAYLOAD + 1, then a good frame
+    uint8_t Stream[4 + PROTOCOL_FRAME_SIZE(PROTOCOL_TIME_SIZE)] = {
+        PROTOCOL_SYNC, PROTOCOL_MSG_TIME, (PROTOCOL_MAX_PAYLOAD + 1) & 0xFF, (PROTOCOL_MAX_PAYLOAD + 1) >> 8,
+    };
+    PROTOCOL_TIME Time = {7, 45, 1, 6, 30};
+    Protocol_EncodeTime(Stream + 4, sizeof(Stream) - 4, &Time);
+
+    PROTOCOL_PARSER Parser;
+    Protocol_Init(&Parser);
+    Received.clear();
+    Protocol_Feed(&Parser, Stream, sizeof(Stream), OnFrame, NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, Parser.Stats.LengthErrors);
+    TEST_ASSERT_EQUAL_UINT32(1, Received.size());
+    TEST_ASSERT_EQUAL_UINT8(PROTOCOL_MSG_TIME, Received[0].Type);
+}
+
+static void test_truncated_frame_is_dropped_on_idle(void)
+{
+    uint8_t Frame[PROTOCOL_FRAME_SIZE(PROTOCOL_ALARM_SIZE)];
+    PROTOCOL_ALARM Alarm = {6, 30, 1};
+    uint16_t Size = Protocol_EncodeAlarm(Frame, sizeof(Frame), &Alarm);
+
+    PROTOCOL_PARSER Parser;
+    Protocol_Init(&Parser);
+    Received.clear();
+    Protocol_Feed(&Parser, Frame, Size - 1, OnFrame, NULL);
+    Protocol_Idle(&Parser, OnFrame, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, Received.size());
+    TEST_ASSERT_EQUAL_UINT32(1, Parser.Stats.Incomplete);
+
+    //The parser is back in sync for the next frame
+    Protocol_Feed(&Parser, Frame, Size, OnFrame, NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, Received.size());
+}
+
+static void test_codecs_round_trip(void)
+{
+    uint8_t Frame[PROTOCOL_FRAME_SIZE(PROTOCOL_MAX_PAYLOAD)];
+    PROTOCOL_PARSER Parser;
+    Protocol_Init(&Parser);
+    Received.clear();
+
+    PROTOCOL_TIME Time = {23, 59, 1, 7, 1};
+    Protocol_Feed(&Parser, Frame, Protocol_EncodeTime(Frame, sizeof(Frame), &Time), OnFrame, NULL);
+    PROTOCOL_ALARM Alarm = {6, 30, 0};
+    Protocol_Feed(&Parser, Frame, Protocol_EncodeAlarm(Frame, sizeof(Frame), &Alarm), OnFrame, NULL);
+    PROTOCOL_TELEMETRY_REQUEST Request = {600};
+    Protocol_Feed(&Parser, Frame, Protocol_EncodeTelemetryRequest(Frame, sizeof(Frame), &Request), OnFrame, NULL);
+    PROTOCOL_TELEMETRY Telemetry;
+    uint32_t *Field = (uint32_t *)&Telemetry;
+    for (size_t i = 0; i < sizeof(Telemetry) / sizeof(uint32_t); i++)
+        Field[i] = 0x01020304u * (i + 1);
+    Protocol_Feed(&Parser, Frame, Protocol_EncodeTelemetry(Frame, sizeof(Frame), &Telemetry), OnFrame, NULL);
+    PROTOCOL_REGION Region = {16, 300, 24, 2, PROTOCOL_REGION_REFRESH};
+    const uint8_t Rows[] = {0xFB, 0xFF};     //PackBits: 6 x 0xFF
+    Protocol_Feed(&Parser, Frame, Protocol_EncodeRegion(Frame, sizeof(Frame), &Region, Rows, sizeof(Rows)), OnFrame, NULL);
+    TEST_ASSERT_EQUAL_UINT32(5, Received.size());
+
+    PROTOCOL_FRAME f;
+    f.Type = Received[0].Type; f.Len = Received[0].Payload.size(); f.Payload = Received[0].Payload.data();
+    PROTOCOL_TIME TimeOut;
+    TEST_ASSERT_TRUE(Protocol_DecodeTime(&f, &TimeOut));
+    TEST_ASSERT_FALSE(Protocol_DecodeAlarm(&f, &Alarm));
+    TEST_ASSERT_EQUAL_MEMORY(&Time, &TimeOut, sizeof(Time));
+
+    f.Type = Received[1].Type; f.Len = Received[1].Payload.size(); f.Payload = Received[1].Payload.data();
+    PROTOCOL_ALARM AlarmOut;
+    TEST_ASSERT_TRUE(Protocol_DecodeAlarm(&f, &AlarmOut));
+    TEST_ASSERT_EQUAL_MEMORY(&Alarm, &AlarmOut, sizeof(Alarm));
+
+    f.Type = Received[2].Type; f.Len = Received[2].Payload.size(); f.Payload = Received[2].Payload.data();
+    PROTOCOL_TELEMETRY_REQUEST RequestOut;
+    TEST_ASSERT_TRUE(Protocol_DecodeTelemetryRequest(&f, &RequestOut));
+    TEST_ASSERT_EQUAL_UINT16(600, RequestOut.Interval);
+
+    f.Type = Received[3].Type; f.Len = Received[3].Payload.size(); f.Payload = Received[3].Payload.data();
+    PROTOCOL_TELEMETRY TelemetryOut;
+    TEST_ASSERT_TRUE(Protocol_DecodeTelemetry(&f, &TelemetryOut));
+    TEST_ASSERT_EQUAL_MEMORY(&Telemetry, &TelemetryOut, sizeof(Telemetry));
+
+    f.Type = Received[4].Type; f.Len = Received[4].Payload.size(); f.Payload = Received[4].Payload.data();
+    PROTOCOL_REGION RegionOut;
+    const uint8_t *Data;
+    uint16_t Len;
+    TEST_ASSERT_TRUE(Protocol_DecodeRegion(&f, &RegionOut, &Data, &Len));
+    TEST_ASSERT_EQUAL_UINT16(16, RegionOut.X);
+    TEST_ASSERT_EQUAL_UINT16(300, RegionOut.Y);
+    TEST_ASSERT_EQUAL_UINT16(24, RegionOut.W);
+    TEST_ASSERT_EQUAL_UINT16(2, RegionOut.H);
+    TEST_ASSERT_EQUAL_UINT8(PROTOCOL_REGION_REFRESH, RegionOut.Flags);
+    TEST_ASSERT_EQUAL_UINT16(sizeof(Rows), Len);
+    TEST_ASSERT_EQUAL_MEMORY(Rows, Data, sizeof(Rows));
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_split_garbage_and_corruption);
+    RUN_TEST(test_oversized_length_is_rejected);
+    RUN_TEST(test_truncated_frame_is_dropped_on_idle);
+    RUN_TEST(test_codecs_round_trip);
+    return UNITY_END();
+}
@@ -0,0 +1,625 @@
+#!/usr/bin/env python3
+"""Convert source images and fonts into the C arrays used by the display.
+
+Images (PNG, PBM or PGM) become framebuffer-layout arrays for Paint_DrawBitMap(),
+Paint_DrawImage() and Paint_BlitImage():
+
+    tools/assets.py image assets/splash.png --rotate 270 --name dayrise_splashscreen \\
+        -o src/images/Splash.c
+
+Fonts become sFONT tables. They are rendered from a TTF (needs Pillow) or
+re-cut from an existing dot-Factory table, e.g. to keep only the clock digits:
+
+    tools/assets.py font --ttf RobotoMono-Medium.ttf --size 96 --chars "0-9:" \\
+        --name FontRoboto72 -o src/fonts/fontRoboto72.cpp
+    tools/assets.py font --from-c src/fonts/fontRoboto72.cpp --chars " 0-9:" \\
+        --name FontClock72 -o src/fonts/fontClock72.cpp
+
+Gray atlases (sFONT_GRAY) hold 2 bpp ink coverage of some glyphs of an sFONT,
+laid out like the framebuffer for one rotation (see GUI_Atlas.h). The
+coverage comes from a TTF (needs Pillow) or is estimated from the 1-bpp table
+by smoothing its edges:
+
+    tools/assets.py atlas --from-c src/fonts/fontRoboto72.cpp --chars "0-9:" \\
+        --rotate 270 --name FontRoboto72_Gray -o src/fonts/fontRoboto72Gray.cpp
+
+Options:
+    --rotate 0|90|180|270   Canvas rotation the image is drawn with. The image
+                            is given as seen on the panel and stored in the
+                            rotated framebuffer layout, like Paint_SetPixel().
+    --bpp 1|2               1 = black/white (bit 1 = WHITE), 2 = 4 gray levels
+                            in the scale 4 layout (0 = black ... 3 = white,
+                            like WHITE % 4 and EPD_3IN52_display_4Gray()).
+    --dither none|bayer|fs  Ordered 8x8 Bayer or Floyd-Steinberg dithering of
+                            gray pixels, "none" rounds to the nearest level.
+                            Same results as GUI_Dither.cpp on the device.
+    --rle                   PackBits compression, see GUI_Paint.h. The array
+                            then starts with the compressed stream.
+
+Only the standard library is needed, except for --ttf.
+"""
+
+import argparse
+import os
+import re
+import shlex
+import struct
+import sys
+import zlib
+
+BAYER8 = [
+    [0, 32, 8, 40, 2, 34, 10, 42],
+    [48, 16, 56, 24, 50, 18, 58, 26],
+    [12, 44, 4, 36, 14, 46, 6, 38],
+    [60, 28, 52, 20, 62, 30, 54, 22],
+    [3, 35, 11, 43, 1, 33, 9, 41],
+    [51, 19, 59, 27, 49, 17, 57, 25],
+    [15, 47, 7, 39, 13, 45, 5, 37],
+    [63, 31, 55, 23, 61, 29, 53, 21],
+]
+
+
+class AssetError(Exception):
+    pass
+
+
+# ---------------------------------------------------------------------------
+# Image readers, all return (width, height, rows of 0..255 gray values)
+# ---------------------------------------------------------------------------
+
+def _paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(data):
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise AssetError("not a PNG file")
+    pos = 8
+    idat = b""
+    palette = None
+    trns = None
+    while pos < len(data):
+        length, ctype = struct.unpack(">I4s", data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if ctype == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif ctype == b"PLTE":
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif ctype == b"tRNS":
+            trns = chunk
+        elif ctype == b"IDAT":
+            idat += chunk
+        elif ctype == b"IEND":
+            break
+    if interlace:
+        raise AssetError("interlaced PNG is not supported")
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color]
+    if depth == 16:
+        raise AssetError("16-bit PNG is not supported")
+    bpp = max(1, channels * depth // 8)
+    stride = (width * channels * depth + 7) // 8
+    raw = zlib.decompress(idat)
+
+    rows = []
+    prev = bytearray(stride)
+    for y in range(height):
+        ftype = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if ftype == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif ftype == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif ftype == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif ftype == 4:
+                line[i] = (line[i] + _paeth(a, b, c)) & 0xFF
+        prev = line
+
+        if depth < 8:
+            per = 8 // depth
+            samples = [(line[x // per] >> (8 - depth * (x % per + 1))) & ((1 << depth) - 1)
+                       for x in range(width)]
+        else:
+            samples = list(line)
+
+        out = []
+        for x in range(width):
+            if color == 0:
+                v = samples[x] * 255 // ((1 << depth) - 1)
+                out.append(v)
+            elif color == 3:
+                r, g, b_ = palette[samples[x]]
+                alpha = trns[samples[x]] if trns is not None and samples[x] < len(trns) else 255
+                out.append(_over_white(_luma(r, g, b_), alpha))
+            elif color == 4:
+                out.append(_over_white(samples[2 * x], samples[2 * x + 1]))
+            else:
+                r, g, b_ = samples[channels * x:channels * x + 3]
+                alpha = samples[channels * x + 3] if channels == 4 else 255
+                out.append(_over_white(_luma(r, g, b_), alpha))
+        rows.append(out)
+    return width, height, rows
+
+
+def _luma(r, g, b):
+    return (299 * r + 587 * g + 114 * b) // 1000
+
+
+def _over_white(v, alpha):
+    return (v * alpha + 255 * (255 - alpha)) // 255
+
+
+def read_pnm(data):
+    tokens = []
+    pos = 0
+    while len(tokens) < 4:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            while data[pos:pos + 1] not in (b"\n", b""):
+                pos += 1
+            continue
+        start = pos
+        while not data[pos:pos + 1].isspace():
+            pos += 1
+        tokens.append(data[start:pos])
+        if tokens[0] == b"P4" and len(tokens) == 3:
+            break
+    pos += 1
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+    rows = []
+    if magic == b"P4":
+        stride = (width + 7) // 8
+        for y in range(height):
+            line = data[pos + y * stride:pos + (y + 1) * stride]
+            rows.append([0 if (line[x // 8] >> (7 - x % 8)) & 1 else 255 for x in range(width)])
+    elif magic == b"P5":
+        maxval = int(tokens[3])
+        if maxval > 255:
+            raise AssetError("16-bit PGM is not supported")
+        for y in range(height):
+            line = data[pos + y * width:pos + (y + 1) * width]
+            rows.append([v * 255 // maxval for v in line])
+    else:
+        raise AssetError("only binary PBM (P4) and PGM (P5) are supported")
+    return width, height, rows
+
+
+def read_image(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] == b"\x89PNG\r\n\x1a\n":
+        return read_png(data)
+    return read_pnm(data)
+
+
+# ---------------------------------------------------------------------------
+# Processing
+# ---------------------------------------------------------------------------
+
+def rotate_to_framebuffer(width, height, rows, rotate):
+    """Return the image in framebuffer layout, as Paint_SetPixel() maps it."""
+    if rotate == 0:
+        return width, height, rows
+    if rotate == 180:
+        return width, height, [list(reversed(r)) for r in reversed(rows)]
+    # 90 and 270 swap the axes: the framebuffer is height pixels wide
+    fb = [[0] * height for _ in range(width)]
+    for y in range(height):
+        for x in range(width):
+            if rotate == 90:
+                fb[x][height - y - 1] = rows[y][x]
+            else:
+                fb[width - x - 1][y] = rows[y][x]
+    return height, width, fb
+
+
+def _div16(v):
+    """C integer division by 16, rounding towards zero."""
+    return -(-v // 16) if v < 0 else v // 16
+
+
+def quantize(width, height, rows, levels, dither):
+    """Map 0..255 gray to 0..levels-1, 0 = black."""
+    steps = levels - 1
+    out = [[0] * width for _ in range(height)]
+    if dither == "fs":
+        # Same integer arithmetic as Dither_Row() in GUI_Dither.cpp: errors in
+        # 1/16 gray steps, only the current and the next row are kept
+        cur = [0] * (width + 2)
+        for y in range(height):
+            nxt = [0] * (width + 2)
+            for x in range(width):
+                value = min(255 * 16, max(0, rows[y][x] * 16 + cur[x + 1]))
+                q = (value * steps + 255 * 8) // (255 * 16)
+                out[y][x] = q
+                e = value - q * 255 // steps * 16
+                right, left, below = _div16(e * 7), _div16(e * 3), _div16(e * 5)
+                cur[x + 2] += right
+                nxt[x] += left
+                nxt[x + 1] += below
+                nxt[x + 2] += e - right - left - below
+            cur = nxt
+        return out
+    for y in range(height):
+        for x in range(width):
+            v = rows[y][x] * steps / 255
+            if dither == "bayer":
+                q = int(v + (BAYER8[y % 8][x % 8] + 0.5) / 64)
+            else:
+                q = int(v + 0.5)
+            out[y][x] = min(steps, q)
+    return out
+
+
+def pack(width, height, levels, bpp):
+    """Pack quantized pixels MSB first, like the Paint scale 2 and 4 layouts."""
+    per = 8 // bpp
+    stride = (width + per - 1) // per
+    data = bytearray()
+    for y in range(height):
+        line = bytearray(stride)
+        if bpp == 1:
+            line = bytearray(b"\xff" * stride)      # WHITE padding, like Paint_Clear()
+        for x in range(width):
+            if bpp == 1:
+                if levels[y][x] == 0:
+                    line[x // 8] &= ~(0x80 >> (x % 8)) & 0xFF
+            else:
+                line[x // 4] |= levels[y][x] << (6 - 2 * (x % 4))     # 3 = white
+        data += line
+    return bytes(data)
+
+
+def packbits(data):
+    """PackBits: n = 0..127 copies n+1 bytes, n = 129..255 repeats the next byte 257-n times."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 128 and data[i + run] == data[i]:
+            run += 1
+        if run >= 2:
+            out += bytes((257 - run, data[i]))
+            i += run
+            continue
+        start = i
+        i += 1
+        while i < len(data) and i - start < 128:
+            if i + 1 < len(data) and data[i] == data[i + 1]:
+                break
+            i += 1
+        out.append(i - start - 1)
+        out += data[start:i]
+    return bytes(out)
+
+
+def unpackbits(data, size):
+    out = bytearray()
+    i = 0
+    while len(out) < size:
+        n = data[i]
+        i += 1
+        if n < 128:
+            out += data[i:i + n + 1]
+            i += n + 1
+        elif n > 128:
+            out += bytes((data[i],)) * (257 - n)
+            i += 1
+    return bytes(out)
+
+
+# ---------------------------------------------------------------------------
+# Fonts
+# ---------------------------------------------------------------------------
+
+def parse_chars(spec):
+    """"0-9:" -> sorted characters, ranges written as a-b, "-" alone is kept."""
+    chars = set()
+    i = 0
+    while i < len(spec):
+        if i + 2 < len(spec) and spec[i + 1] == "-":
+            for c in range(ord(spec[i]), ord(spec[i + 2]) + 1):
+                chars.add(chr(c))
+            i += 3
+        else:
+            chars.add(spec[i])
+            i += 1
+    for c in chars:
+        if not " " <= c <= "~":
+            raise AssetError("character %r is outside ' '..'~'" % c)
+    return sorted(chars)
+
+
+def font_from_c(path):
+    """Read a dot-Factory sFONT file: returns (width, height, {char: glyph bytes})."""
+    with open(path) as f:
+        text = re.sub(r"//[^\n]*|/\*.*?\*/", "", f.read(), flags=re.S)
+    m = re.search(r"sFONT\s+\w+\s*=\s*\{([^}]*)\}", text)
+    if m is None:
+        raise AssetError("no sFONT definition in " + path)
+    fields = [v.strip() for v in m.group(1).split(",") if v.strip()]
+    width, height = int(fields[1]), int(fields[2])
+    first = int(fields[3]) if len(fields) > 3 and int(fields[3]) else ord(" ")
+    start = text.index("{", re.search(r"_table\s*\[", text, flags=re.I).end())
+    body = text[start:text.index("}", start)]
+    table = bytes(int(v, 16) for v in re.findall(r"0x([0-9A-Fa-f]{2})", body))
+    size = height * ((width + 7) // 8)
+    glyphs = {chr(first + i): table[i * size:(i + 1) * size] for i in range(len(table) // size)}
+    return width, height, glyphs
+
+
+def font_from_ttf(path, size, chars):
+    try:
+        from PIL import Image, ImageDraw, ImageFont
+    except ImportError:
+        raise AssetError("--ttf needs Pillow (pip install pillow)")
+    font = ImageFont.truetype(path, size)
+    ascent, descent = font.getmetrics()
+    width = max(int(round(font.getlength(c))) for c in chars)
+    height = ascent + descent
+    stride = (width + 7) // 8
+    glyphs = {}
+    for c in chars:
+        img = Image.new("L", (width, height), 0)
+        ImageDraw.Draw(img).text((0, 0), c, font=font, fill=255)
+        data = bytearray(stride * height)
+        for y in range(height):
+            for x in range(width):
+                if img.getpixel((x, y)) >= 128:
+                    data[y * stride + x // 8] |= 0x80 >> (x % 8)
+        glyphs[c] = bytes(data)
+    return width, height, glyphs
+
+
+def coverage_from_mono(width, height, glyph):
+    """Estimate 0..3 ink coverage of a 1-bpp glyph: 3x3 weighted box filter
+    (4 center, 2 edge, 1 corner neighbours), so only the edges turn gray."""
+    stride = (width + 7) // 8
+
+    def ink(x, y):
+        if 0 <= x < width and 0 <= y < height:
+            return (glyph[y * stride + x // 8] >> (7 - x % 8)) & 1
+        return 0
+
+    rows = []
+    for y in range(height):
+        row = []
+        for x in range(width):
+            total = 4 * ink(x, y)
+            total += 2 * (ink(x - 1, y) + ink(x + 1, y) + ink(x, y - 1) + ink(x, y + 1))
+            total += ink(x - 1, y - 1) + ink(x + 1, y - 1) + ink(x - 1, y + 1) + ink(x + 1, y + 1)
+            row.append((total * 3 + 8) // 16)
+        rows.append(row)
+    return rows
+
+
+def coverage_from_ttf(path, size, width, height, chars):
+    """Render the glyphs anti-aliased into the cell of the 1-bpp font."""
+    try:
+        from PIL import Image, ImageDraw, ImageFont
+    except ImportError:
+        raise AssetError("--ttf needs Pillow (pip install pillow)")
+    font = ImageFont.truetype(path, size)
+    glyphs = {}
+    for c in chars:
+        img = Image.new("L", (width, height), 0)
+        ImageDraw.Draw(img).text((0, 0), c, font=font, fill=255)
+        glyphs[c] = [[(img.getpixel((x, y)) * 3 + 127) // 255 for x in range(width)]
+                     for y in range(height)]
+    return glyphs
+
+
+# ---------------------------------------------------------------------------
+# Writers
+# ---------------------------------------------------------------------------
+
+def command_line():
+    """The command that reproduces an output, written into its header."""
+    return " ".join(shlex.quote(a) for a in ["tools/assets.py"] + sys.argv[1:])
+
+
+def c_bytes(data, indent="\t", per_line=16):
+    lines = []
+    for i in range(0, len(data), per_line):
+        lines.append(indent + " ".join("0x%02x," % b for b in data[i:i + per_line]))
+    return "\n".join(lines)
+
+
+def write_image(args, data, width, height, raw_size):
+    fmt = "PackBits, %d bytes unpacked" % raw_size if args.rle else "raw"
+    out = []
+    out.append("// Erzeugt mit tools/assets.py aus %s, nicht von Hand bearbeiten" % os.path.basename(args.input))
+    out.append("// %s" % command_line())
+    out.append("// %d x %d Pixel im Framebuffer, %d bpp, %s" % (width, height, args.bpp, fmt))
+    out.append("")
+    out.append('#include "ImageData.h"')
+    out.append("")
+    out.append("const unsigned char %s[%d] = {" % (args.name, len(data)))
+    out.append(c_bytes(data))
+    out.append("};")
+    with open(args.output, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+def write_font(args, width, height, glyphs, chars):
+    first, last = chars[0], chars[-1]
+    stride = (width + 7) // 8
+    blank = bytes(stride * height)
+    out = ['#include "fonts.h"', "//", "//  Font data, erzeugt mit tools/assets.py", "//",
+           "//  %s" % command_line(), "//", "",
+           "const uint8_t %s_table[] = " % args.name, "{"]
+    offset = 0
+    for code in range(ord(first), ord(last) + 1):
+        c = chr(code)
+        data = glyphs.get(c, blank) if c in chars else blank
+        if len(data) != len(blank):
+            raise AssetError("glyph %r has the wrong size" % c)
+        out.append("\t// @%d '%s' (%d pixels wide)%s" % (offset, c, width, "" if c in chars else " leer"))
+        out.append(c_bytes(data, per_line=len(data)))
+        out.append("")
+        offset += len(data)
+    out.append("};")
+    out.append("")
+    out.append("sFONT %s = {" % args.name)
+    out.append("  %s_table," % args.name)
+    out.append("  %d, /* Width */" % width)
+    out.append("  %d, /* Height */" % height)
+    out.append("  %d, /* First '%s' */" % (ord(first), first))
+    out.append("  %d, /* Last '%s' */" % (ord(last), last))
+    out.append("};")
+    with open(args.output, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+def write_atlas(args, mono, width, height, rows, stride, data, chars):
+    first, last = chars[0], chars[-1]
+    size = rows * stride
+    source = "%s, %d px" % (os.path.basename(args.ttf), args.size) if args.ttf else \
+        "der 1-bpp Tabelle, Kanten geglättet"
+    out = ['#include "fonts.h"', "//", "//  2 bpp Glyph-Atlas, erzeugt mit tools/assets.py aus %s" % source,
+           "//", "//  %s" % command_line(), "//",
+           "//  %d x %d Pixel je Zeichen, im Framebuffer %d Zeilen zu %d Bytes (ROTATE_%d)"
+           % (width, height, rows, stride, args.rotate), "//", "",
+           "const uint8_t %s_table[] = " % args.name, "{"]
+    for i, code in enumerate(range(ord(first), ord(last) + 1)):
+        c = chr(code)
+        out.append("\t// @%d '%s'%s" % (i * size, c, "" if c in chars else " leer"))
+        out.append(c_bytes(data[i * size:(i + 1) * size], per_line=stride))
+        out.append("")
+    out.append("};")
+    out.append("")
+    out.append("sFONT_GRAY %s = {" % args.name)
+    out.append("  %s_table," % args.name)
+    out.append("  &%s," % mono)
+    out.append("  %d, /* Rotate */" % args.rotate)
+    out.append("  %d, /* Rows */" % rows)
+    out.append("  %d, /* WidthByte */" % stride)
+    out.append("  %d, /* First '%s' */" % (ord(first), first))
+    out.append("  %d, /* Last '%s' */" % (ord(last), last))
+    out.append("};")
+    with open(args.output, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+# ---------------------------------------------------------------------------
+# Commands
+# ---------------------------------------------------------------------------
+
+def cmd_image(args):
+    width, height, rows = read_image(args.input)
+    width, height, rows = rotate_to_framebuffer(width, height, rows, args.rotate)
+    levels = quantize(width, height, rows, 2 ** args.bpp, args.dither)
+    data = pack(width, height, levels, args.bpp)
+    raw_size = len(data)
+    if args.rle:
+        packed = packbits(data)
+        assert unpackbits(packed, raw_size) == data
+        data = packed
+    write_image(args, data, width, height, raw_size)
+    print("%s: %d x %d, %d bytes%s" % (args.output, width, height, len(data),
+          " (%d unpacked)" % raw_size if args.rle else ""))
+
+
+def cmd_font(args):
+    if (args.ttf is None) == (args.from_c is None):
+        raise AssetError("give either --ttf or --from-c")
+    chars = parse_chars(args.chars)
+    if args.ttf is not None:
+        if args.size is None:
+            raise AssetError("--ttf needs --size")
+        width, height, glyphs = font_from_ttf(args.ttf, args.size, chars)
+    else:
+        width, height, glyphs = font_from_c(args.from_c)
+        missing = [c for c in chars if c not in glyphs]
+        if missing:
+            raise AssetError("%s has no glyph for %s" % (args.from_c, "".join(missing)))
+    write_font(args, width, height, glyphs, chars)
+    size = (ord(chars[-1]) - ord(chars[0]) + 1) * height * ((width + 7) // 8)
+    print("%s: %d x %d, '%s'..'%s', %d bytes" % (args.output, width, height, chars[0], chars[-1], size))
+
+
+def cmd_atlas(args):
+    chars = parse_chars(args.chars)
+    width, height, mono = font_from_c(args.from_c)
+    missing = [c for c in chars if c not in mono]
+    if missing:
+        raise AssetError("%s has no glyph for %s" % (args.from_c, "".join(missing)))
+    if args.ttf is not None:
+        if args.size is None:
+            raise AssetError("--ttf needs --size")
+        coverage = coverage_from_ttf(args.ttf, args.size, width, height, chars)
+    else:
+        coverage = {c: coverage_from_mono(width, height, mono[c]) for c in chars}
+
+    name = re.search(r"sFONT\s+(\w+)\s*=", open(args.from_c).read()).group(1)
+    data = bytearray()
+    blank = [[0] * width for _ in range(height)]
+    for code in range(ord(chars[0]), ord(chars[-1]) + 1):
+        c = chr(code)
+        fb_width, rows, fb = rotate_to_framebuffer(width, height, coverage.get(c, blank), args.rotate)
+        # Lines padded to whole 32 bit words for the blitter
+        stride = ((fb_width + 3) // 4 + 3) // 4 * 4
+        for line in fb:
+            packed = bytearray(stride)
+            for x, v in enumerate(line):
+                packed[x // 4] |= v << (6 - 2 * (x % 4))
+            data += packed
+    write_atlas(args, name, width, height, rows, stride, data, chars)
+    mono_size = len(chars) * height * ((width + 7) // 8)
+    print("%s: %d x %d, '%s'..'%s', %d bytes (1 bpp: %d bytes)" % (args.output, width, height,
+          chars[0], chars[-1], len(data), mono_size))
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("image", help="PNG/PBM/PGM to a framebuffer array")
+    p.add_argument("input")
+    p.add_argument("-o", "--output", required=True)
+    p.add_argument("--name", required=True, help="C array name")
+    p.add_argument("--rotate", type=int, choices=(0, 90, 180, 270), default=0)
+    p.add_argument("--bpp", type=int, choices=(1, 2), default=1)
+    p.add_argument("--dither", choices=("none", "bayer", "fs"), default="none")
+    p.add_argument("--rle", action="store_true", help="PackBits compression")
+    p.set_defaults(func=cmd_image)
+
+    p = sub.add_parser("font", help="TTF or dot-Factory table to an sFONT")
+    p.add_argument("-o", "--output", required=True)
+    p.add_argument("--name", required=True, help="sFONT name")
+    p.add_argument("--ttf")
+    p.add_argument("--size", type=int, help="TTF pixel size")
+    p.add_argument("--from-c", help="existing font .cpp to cut a subset from")
+    p.add_argument("--chars", default=" -~", help='glyph subset, e.g. " 0-9:"')
+    p.set_defaults(func=cmd_font)
+
+    p = sub.add_parser("atlas", help="2 bpp anti-aliased glyph atlas of an sFONT")
+    p.add_argument("-o", "--output", required=True)
+    p.add_argument("--name", required=True, help="sFONT_GRAY name")
+    p.add_argument("--from-c", required=True, help="the 1-bpp font: metrics, fallback and source")
+    p.add_argument("--ttf", help="render the coverage from this TTF instead")
+    p.add_argument("--size", type=int, help="TTF pixel size")
+    p.add_argument("--chars", default="0-9:", help="glyph subset, stored as one range")
+    p.add_argument("--rotate", type=int, choices=(0, 90, 180, 270), default=270)
+    p.set_defaults(func=cmd_atlas)
+
+    args = parser.parse_args(argv)
+    try:
+        args.func(args)
+    except (AssetError, OSError) as e:
+        sys.exit("assets.py: %s" % e)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,49 @@
+"""PlatformIO pre-build step: regenerate the assets listed in assets/assets.txt.
+
+Every line of the manifest holds the arguments of one tools/assets.py call. A
+line is run again when its output is missing or older than one of its inputs
+or than tools/assets.py itself.
+"""
+
+import os
+import shlex
+import subprocess
+
+Import("env")  # noqa: F821 (provided by PlatformIO)
+
+ROOT = env.subst("$PROJECT_DIR")  # noqa: F821
+MANIFEST = os.path.join(ROOT, "assets", "assets.txt")
+TOOL = os.path.join(ROOT, "tools", "assets.py")
+INPUT_OPTIONS = ("--ttf", "--from-c")
+
+
+def inputs_and_output(args):
+    inputs, output = [TOOL, MANIFEST], None
+    for i, arg in enumerate(args):
+        if arg in ("-o", "--output"):
+            output = args[i + 1]
+        elif arg in INPUT_OPTIONS:
+            inputs.append(args[i + 1])
+    # The positional argument of "image" is its input
+    if args and args[0] == "image":
+        inputs.append(args[1])
+    return [os.path.join(ROOT, p) for p in inputs], os.path.join(ROOT, output)
+
+
+def stale(inputs, output):
+    if not os.path.exists(output):
+        return True
+    mtime = os.path.getmtime(output)
+    return any(os.path.getmtime(p) > mtime for p in inputs if os.path.exists(p))
+
+
+if os.path.exists(MANIFEST):
+    with open(MANIFEST) as f:
+        for line in f:
+            args = shlex.split(line, comments=True)
+            if not args:
+                continue
+            inputs, output = inputs_and_output(args)
+            if stale(inputs, output):
+                print("assets: " + " ".join(args))
+                subprocess.check_call([env.subst("$PYTHONEXE"), TOOL] + args, cwd=ROOT)  # noqa: F821
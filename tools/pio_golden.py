@@ -0,0 +1,62 @@
+"""PlatformIO post-build step of env:render: the "golden" target.
+
+    pio run -e render -t golden
+
+Renders every screen listed in test/golden/golden.txt with the host renderer
+and compares it with render --compare against its golden PBM. The target
+fails if any pixel differs. With GOLDEN_UPDATE=1 in the environment the
+golden files are rewritten from the current output instead.
+"""
+
+import os
+import shlex
+import shutil
+import subprocess
+
+Import("env")  # noqa: F821 (provided by PlatformIO)
+
+ROOT = env.subst("$PROJECT_DIR")  # noqa: F821
+GOLDEN_DIR = os.path.join(ROOT, "test", "golden")
+MANIFEST = os.path.join(GOLDEN_DIR, "golden.txt")
+PROGRAM = "$BUILD_DIR/${PROGNAME}${PROGSUFFIX}"
+
+
+def cases():
+    with open(MANIFEST) as f:
+        for line in f:
+            line = line.strip()
+            if line and not line.startswith("#"):
+                args = shlex.split(line)
+                yield args[:-1], args[-1]
+
+
+def check_golden(target, source, env):
+    program = env.subst(PROGRAM)
+    out_dir = os.path.join(env.subst("$BUILD_DIR"), "golden")
+    os.makedirs(out_dir, exist_ok=True)
+    update = os.environ.get("GOLDEN_UPDATE") == "1"
+
+    failed = 0
+    for args, name in cases():
+        out = os.path.join(out_dir, name)
+        golden = os.path.join(GOLDEN_DIR, name)
+        if update:
+            result = subprocess.run([program] + args + [out])
+            if result.returncode == 0:
+                shutil.copyfile(out, golden)
+                print("updated %s" % name)
+        else:
+            result = subprocess.run([program] + args + [out, "--compare", golden])
+        if result.returncode != 0:
+            print("FAILED: render %s" % " ".join(args + [name]))
+            failed += 1
+    return 1 if failed else 0
+
+
+env.AddCustomTarget(  # noqa: F821
+    name="golden",
+    dependencies=PROGRAM,
+    actions=[check_golden],
+    title="Golden screens",
+    description="Render the screens of test/golden/golden.txt and compare them pixel by pixel",
+)
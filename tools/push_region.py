@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""Send a screen to the display as PROTOCOL_MSG_REGION frames.
+
+The image is given as seen on the panel, like "tools/assets.py image", and
+converted to the framebuffer layout. With --previous only the bounding box of
+the bytes that differ from the screen shown before is sent, otherwise the
+whole framebuffer. The region is cut into bands of whole rows whose PackBits
+data fits one frame (see lib/DayriseProtocol), the last band asks the display
+to refresh:
+
+    stty -F /dev/ttyUSB0 115200 raw
+    tools/push_region.py screen.png --previous last.png -o /dev/ttyUSB0
+
+Every frame is preceded by PROTOCOL_WAKE and a short pause, like
+sendFrame() of the master, because the display may be in light sleep. The
+bytes-per-update budget (raw, compressed, on the line and over SPI) is
+printed, -o can be left out to only measure it.
+
+Only the standard library is needed.
+"""
+
+import argparse
+import os
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from assets import (AssetError, pack, packbits, quantize, read_image,  # noqa: E402
+                    rotate_to_framebuffer, unpackbits)
+
+# lib/DayriseProtocol/src/DayriseProtocol.h
+SYNC = 0xA5
+HEADER_SIZE = 4
+CRC_SIZE = 2
+WAKE = 0x00
+WAKE_MS = 3
+MAX_PAYLOAD = 256
+MSG_REGION = 0x04
+REGION_SIZE = 9
+REGION_REFRESH = 0x01
+REGION_DATA = MAX_PAYLOAD - REGION_SIZE
+
+# src/utility/EPD_3in52.h, the framebuffer of the display
+FB_WIDTH = 240
+FB_HEIGHT = 360
+BAUD = 115200
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC16-CCITT like Protocol_Crc16()."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021 if crc & 0x8000 else crc << 1) & 0xFFFF
+    return crc
+
+
+def encode_frame(msg_type, payload):
+    body = bytes((msg_type, len(payload) & 0xFF, len(payload) >> 8)) + payload
+    crc = crc16(body)
+    return bytes((SYNC,)) + body + bytes((crc & 0xFF, crc >> 8))
+
+
+def encode_region(x, y, w, h, flags, data):
+    header = b"".join(bytes((v & 0xFF, v >> 8)) for v in (x, y, w, h)) + bytes((flags,))
+    return encode_frame(MSG_REGION, header + data)
+
+
+def load_framebuffer(path, rotate, dither):
+    width, height, rows = read_image(path)
+    width, height, rows = rotate_to_framebuffer(width, height, rows, rotate)
+    if (width, height) != (FB_WIDTH, FB_HEIGHT):
+        raise AssetError("%s: %d x %d in the framebuffer, the display has %d x %d"
+                         % (path, width, height, FB_WIDTH, FB_HEIGHT))
+    return pack(width, height, quantize(width, height, rows, 2, dither), 1)
+
+
+def changed_box(data, previous):
+    """Byte-aligned bounding box (x, y, w, h) of the differences, None if equal."""
+    stride = FB_WIDTH // 8
+    box = None
+    for y in range(FB_HEIGHT):
+        row = slice(y * stride, (y + 1) * stride)
+        if data[row] == previous[row]:
+            continue
+        cols = [i for i in range(stride) if data[y * stride + i] != previous[y * stride + i]]
+        if box is None:
+            box = [cols[0], y, cols[-1], y]
+        else:
+            box = [min(box[0], cols[0]), box[1], max(box[2], cols[-1]), y]
+    if box is None:
+        return None
+    return box[0] * 8, box[1], (box[2] - box[0] + 1) * 8, box[3] - box[1] + 1
+
+
+def bands(data, x, y, w, h):
+    """Split the region into (y, rows, packed) bands that fit one frame each."""
+    stride = FB_WIDTH // 8
+    rows = [data[(y + i) * stride + x // 8:(y + i) * stride + (x + w) // 8] for i in range(h)]
+    out = []
+    start = 0
+    while start < h:
+        count = 1
+        packed = packbits(rows[start])
+        # A band grows row by row as long as its compressed data still fits
+        while start + count < h:
+            longer = packbits(b"".join(rows[start:start + count + 1]))
+            if len(longer) > REGION_DATA:
+                break
+            count += 1
+            packed = longer
+        assert unpackbits(packed, count * w // 8) == b"".join(rows[start:start + count])
+        out.append((y + start, count, packed))
+        start += count
+    return out
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("input", help="PNG/PBM/PGM as seen on the panel")
+    parser.add_argument("--previous", help="the screen shown before, only the changes are sent")
+    parser.add_argument("--rotate", type=int, choices=(0, 90, 180, 270), default=270,
+                        help="canvas rotation of the display (default 270)")
+    parser.add_argument("--dither", choices=("none", "bayer", "fs"), default="none")
+    parser.add_argument("-o", "--output", help="serial device or file for the frames")
+    parser.add_argument("--pause", type=float, default=WAKE_MS / 1000,
+                        help="seconds between the wake byte and the frame")
+    args = parser.parse_args(argv)
+
+    try:
+        data = load_framebuffer(args.input, args.rotate, args.dither)
+        box = (0, 0, FB_WIDTH, FB_HEIGHT)
+        if args.previous:
+            box = changed_box(data, load_framebuffer(args.previous, args.rotate, args.dither))
+            if box is None:
+                print("%s: no change, nothing to send" % args.input)
+                return
+        x, y, w, h = box
+
+        cut = bands(data, x, y, w, h)
+        frames = []
+        for i, (band_y, count, packed) in enumerate(cut):
+            flags = REGION_REFRESH if i == len(cut) - 1 else 0
+            frames.append(encode_region(x, band_y, w, count, flags, packed))
+
+        if args.output:
+            with open(args.output, "wb", buffering=0) as out:
+                for frame in frames:
+                    out.write(bytes((WAKE,)))
+                    time.sleep(args.pause)
+                    out.write(frame)
+    except (AssetError, OSError) as e:
+        sys.exit("push_region.py: %s" % e)
+
+    raw = w // 8 * h
+    packed = sum(len(p) for _, _, p in cut)
+    line = sum(len(f) + 1 for f in frames)     # with the wake bytes
+    print("region %d,%d %dx%d: %d bytes raw, %d packed (%.0f%%), %d frames"
+          % (x, y, w, h, raw, packed, packed * 100.0 / raw, len(frames)))
+    print("link: %d bytes, %.0f ms at %d baud, SPI: %d bytes"
+          % (line, line * 10 * 1000.0 / BAUD + len(frames) * args.pause * 1000, BAUD, raw))
+
+
+if __name__ == "__main__":
+    main()